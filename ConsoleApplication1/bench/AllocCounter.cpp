@@ -0,0 +1,62 @@
+﻿#include "AllocCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	std::atomic<uint64_t> g_allocations{ 0 };
+	std::atomic<uint64_t> g_frees{ 0 };
+	std::atomic<uint64_t> g_bytes{ 0 };
+
+	void* CountedAlloc(size_t n) {
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+		g_bytes.fetch_add(n, std::memory_order_relaxed);
+		void* p = malloc(n ? n : 1);
+		if (!p) throw std::bad_alloc();
+		return p;
+	}
+
+	void CountedFree(void* p) {
+		if (!p) return;
+		g_frees.fetch_add(1, std::memory_order_relaxed);
+		free(p);
+	}
+}
+
+uint64_t HeapAllocations() {
+	return g_allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t HeapFrees() {
+	return g_frees.load(std::memory_order_relaxed);
+}
+
+uint64_t HeapBytes() {
+	return g_bytes.load(std::memory_order_relaxed);
+}
+
+// Wersje nothrow i rozmiarowe delete w bibliotece standardowej wołają te poniżej
+void* operator new(size_t n) {
+	return CountedAlloc(n);
+}
+
+void* operator new[](size_t n) {
+	return CountedAlloc(n);
+}
+
+void operator delete(void* p) noexcept {
+	CountedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+	CountedFree(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	CountedFree(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+	CountedFree(p);
+}
@@ -0,0 +1,15 @@
+﻿#pragma once
+#include <cstdint>
+
+// --- ALLOCATION COUNTER ---
+// Liczniki alokacji sterty całego procesu. AllocCounter.cpp zastępuje globalny operator new,
+// więc linkuje się go tylko do programów pomiarowych (bench/, headless), nigdy do gry ani do core.
+
+uint64_t HeapAllocations(); // wywołania operator new od startu procesu
+uint64_t HeapFrees();       // zwolnienia (operator delete z niepustym wskaźnikiem)
+uint64_t HeapBytes();       // suma zamówionych bajtów
+
+// Bloki zaalokowane i jeszcze niezwolnione; stały wzrost w długim przebiegu to wyciek
+inline uint64_t HeapLiveAllocations() {
+	return HeapAllocations() - HeapFrees();
+}
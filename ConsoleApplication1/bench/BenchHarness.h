@@ -0,0 +1,112 @@
+﻿#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// --- BENCH HARNESS ---
+// Wspólne dla benchmarków w bench/: pomiar pojedynczych iteracji, percentyle i zapis JSON.
+// Przy --repeat każde powtórzenie to osobny wpis z polem "run"; bench_compare liczy z nich
+// medianę i MAD.
+// Przygotowanie (setup) idzie przed każdą iteracją poza pomiarem, więc benchmark może
+// zużywać stan (usuwanie, spawn) i zaczynać każdą iterację od tej samej sceny.
+
+struct BenchOptions {
+	double minTime = 0.25;        // sekund pomiaru na benchmark
+	const char* filter = nullptr; // podciąg nazwy; nullptr = wszystkie
+	int run = 0;                  // numer powtórzenia całego zestawu (--repeat)
+};
+
+struct BenchResult {
+	std::string name;
+	int run = 0;
+	size_t entities = 0;
+	uint64_t iterations = 0;
+	double nsPerEntity = 0.0; // mediana iteracji / entities
+	double p50Ns = 0.0, p90Ns = 0.0, p99Ns = 0.0;
+	double minNs = 0.0, maxNs = 0.0;
+};
+
+// Percentyl q z [0, 1] (najbliższy rząd); przestawia v
+inline double Percentile(std::vector<double>& v, double q) {
+	if (v.empty()) return 0.0;
+	size_t k = static_cast<size_t>(q * static_cast<double>(v.size() - 1) + 0.5);
+	std::nth_element(v.begin(), v.begin() + k, v.end());
+	return v[k];
+}
+
+inline bool BenchSelected(const BenchOptions& opt, const std::string& name) {
+	return opt.filter == nullptr || name.find(opt.filter) != std::string::npos;
+}
+
+template <typename Setup, typename Body>
+void RunBench(const BenchOptions& opt, const std::string& name, size_t entities, Setup setup, Body body, std::vector<BenchResult>& out) {
+	constexpr uint64_t C_MIN_ITERATIONS = 10;
+	constexpr size_t C_MAX_SAMPLES = 1'000'000;
+	using Clock = std::chrono::steady_clock;
+	if (!BenchSelected(opt, name)) return;
+
+	// Rozgrzewka: cache, predyktor skoków, pierwsze dotknięcie stron
+	for (int i = 0; i < 3; ++i) {
+		setup();
+		body();
+	}
+
+	std::vector<double> samples;
+	samples.reserve(1024);
+	double measured = 0.0;
+	while ((measured < opt.minTime || samples.size() < C_MIN_ITERATIONS) && samples.size() < C_MAX_SAMPLES) {
+		setup();
+		auto start = Clock::now();
+		body();
+		double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		samples.push_back(ns);
+		measured += ns * 1e-9;
+	}
+
+	BenchResult r;
+	r.name = name;
+	r.run = opt.run;
+	r.entities = entities;
+	r.iterations = samples.size();
+	r.minNs = *std::min_element(samples.begin(), samples.end());
+	r.maxNs = *std::max_element(samples.begin(), samples.end());
+	r.p50Ns = Percentile(samples, 0.50);
+	r.p90Ns = Percentile(samples, 0.90);
+	r.p99Ns = Percentile(samples, 0.99);
+	r.nsPerEntity = entities ? r.p50Ns / static_cast<double>(entities) : r.p50Ns;
+	out.push_back(r);
+
+	printf("%-32s %9zu %9llu %10.3f %12.0f %12.0f %12.0f\n", r.name.c_str(), r.entities,
+		static_cast<unsigned long long>(r.iterations), r.nsPerEntity, r.p50Ns, r.p90Ns, r.p99Ns);
+	fflush(stdout);
+}
+
+inline void PrintBenchHeader() {
+	printf("%-32s %9s %9s %10s %12s %12s %12s\n", "benchmark", "entities", "iters", "ns/entity", "p50 ns", "p90 ns", "p99 ns");
+}
+
+// {"suite": ..., "kernels": ..., "results": [{"name": ..., "run": ..., metryki...}, ...]}; false przy błędzie zapisu
+inline bool WriteBenchJson(const char* path, const char* suite, const char* kernels, const std::vector<BenchResult>& results) {
+	FILE* f = fopen(path, "w");
+	if (!f) {
+		fprintf(stderr, "Cannot write benchmark results: %s\n", path);
+		return false;
+	}
+	fprintf(f, "{\n  \"suite\": \"%s\",\n  \"kernels\": \"%s\",\n  \"results\": [\n", suite, kernels);
+	for (size_t i = 0; i < results.size(); ++i) {
+		const BenchResult& r = results[i];
+		fprintf(f, "    {\"name\": \"%s\", \"run\": %d, \"entities\": %zu, \"iterations\": %llu, \"ns_per_entity\": %.4f, "
+			"\"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, \"min_ns\": %.1f, \"max_ns\": %.1f}%s\n",
+			r.name.c_str(), r.run, r.entities, static_cast<unsigned long long>(r.iterations), r.nsPerEntity,
+			r.p50Ns, r.p90Ns, r.p99Ns, r.minNs, r.maxNs, i + 1 < results.size() ? "," : "");
+	}
+	fprintf(f, "  ]\n}\n");
+	bool ok = ferror(f) == 0;
+	if (fclose(f) != 0) ok = false;
+	if (!ok) fprintf(stderr, "Cannot write benchmark results: %s\n", path);
+	return ok;
+}
@@ -0,0 +1,32 @@
+﻿#include "ProcessMemory.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+size_t ResidentBytes() {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+		return static_cast<size_t>(pmc.WorkingSetSize);
+	}
+	return 0;
+#elif defined(__linux__)
+	// statm: rozmiar, rezydentne, ... w stronach
+	FILE* f = fopen("/proc/self/statm", "r");
+	if (!f) return 0;
+	unsigned long long size = 0, resident = 0;
+	int n = fscanf(f, "%llu %llu", &size, &resident);
+	fclose(f);
+	if (n != 2) return 0;
+	return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,9 @@
+﻿#pragma once
+#include <cstddef>
+
+// --- PROCESS MEMORY ---
+// Pamięć rezydentna procesu (RSS) do długich przebiegów. Osobna jednostka kompilacji,
+// bo <windows.h> gryzie się z raylib.h (Rectangle, CloseWindow, DrawText...).
+
+// Bajty RSS; 0, gdy system nie jest obsługiwany albo odczyt się nie udał
+size_t ResidentBytes();
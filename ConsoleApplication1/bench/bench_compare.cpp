@@ -0,0 +1,347 @@
+﻿#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS // fopen
+#endif
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+// Porównanie dwóch plików JSON z asteroids_bench_micro / _scenario / _capacity (--json).
+// Dla każdego benchmarku i metryki: mediana powtórzeń (wpisy z tym samym "name", różne "run")
+// i MAD jako miara szumu. Regresja = pogorszenie mediany ponad próg metryki, większe niż
+// szum pomiaru (--noise razy odchylenie wyliczone z MAD obu stron). Kod wyjścia: 0 - bez
+// regresji, 1 - regresja, 2 - błąd wejścia.
+
+namespace {
+	// --- minimalny parser JSON (tylko to, co zapisują benchmarki) ---
+	struct JsonValue {
+		enum class Type : uint8_t { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = Type::NUL;
+		double number = 0.0;
+		bool boolean = false;
+		std::string string;
+		std::vector<JsonValue> items;
+		std::vector<std::pair<std::string, JsonValue>> members;
+
+		const JsonValue* Find(const char* key) const {
+			for (const auto& m : members) {
+				if (m.first == key) return &m.second;
+			}
+			return nullptr;
+		}
+	};
+
+	class JsonParser {
+	public:
+		explicit JsonParser(const std::string& text) : s(text) {}
+
+		bool Parse(JsonValue& out) {
+			if (!Value(out, 0)) return false;
+			SkipSpace();
+			if (pos != s.size()) return Fail("trailing characters");
+			return true;
+		}
+
+		const char* Error() const { return error; }
+		size_t Offset() const { return pos; }
+
+	private:
+		static constexpr int C_MAX_DEPTH = 32;
+
+		bool Fail(const char* what) {
+			error = what;
+			return false;
+		}
+
+		void SkipSpace() {
+			while (pos < s.size() && isspace(static_cast<unsigned char>(s[pos]))) ++pos;
+		}
+
+		bool Literal(const char* word) {
+			size_t n = strlen(word);
+			if (s.compare(pos, n, word) != 0) return Fail("unexpected token");
+			pos += n;
+			return true;
+		}
+
+		bool String(std::string& out) {
+			++pos; // "
+			out.clear();
+			while (pos < s.size() && s[pos] != '"') {
+				char c = s[pos++];
+				if (c == '\\') {
+					if (pos >= s.size()) break;
+					char e = s[pos++];
+					switch (e) {
+					case 'n': out += '\n'; break;
+					case 't': out += '\t'; break;
+					case 'r': out += '\r'; break;
+					case 'u': return Fail("\\u escapes are not supported");
+					default: out += e; break;
+					}
+				}
+				else {
+					out += c;
+				}
+			}
+			if (pos >= s.size()) return Fail("unterminated string");
+			++pos;
+			return true;
+		}
+
+		bool Value(JsonValue& v, int depth) {
+			if (depth > C_MAX_DEPTH) return Fail("nesting too deep");
+			SkipSpace();
+			if (pos >= s.size()) return Fail("unexpected end of input");
+			char c = s[pos];
+			if (c == '{') {
+				v.type = JsonValue::Type::OBJECT;
+				++pos;
+				SkipSpace();
+				if (pos < s.size() && s[pos] == '}') { ++pos; return true; }
+				for (;;) {
+					SkipSpace();
+					if (pos >= s.size() || s[pos] != '"') return Fail("expected key");
+					std::pair<std::string, JsonValue> m;
+					if (!String(m.first)) return false;
+					SkipSpace();
+					if (pos >= s.size() || s[pos] != ':') return Fail("expected ':'");
+					++pos;
+					if (!Value(m.second, depth + 1)) return false;
+					v.members.push_back(std::move(m));
+					SkipSpace();
+					if (pos < s.size() && s[pos] == ',') { ++pos; continue; }
+					if (pos < s.size() && s[pos] == '}') { ++pos; return true; }
+					return Fail("expected ',' or '}'");
+				}
+			}
+			if (c == '[') {
+				v.type = JsonValue::Type::ARRAY;
+				++pos;
+				SkipSpace();
+				if (pos < s.size() && s[pos] == ']') { ++pos; return true; }
+				for (;;) {
+					v.items.emplace_back();
+					if (!Value(v.items.back(), depth + 1)) return false;
+					SkipSpace();
+					if (pos < s.size() && s[pos] == ',') { ++pos; continue; }
+					if (pos < s.size() && s[pos] == ']') { ++pos; return true; }
+					return Fail("expected ',' or ']'");
+				}
+			}
+			if (c == '"') {
+				v.type = JsonValue::Type::STRING;
+				return String(v.string);
+			}
+			if (c == 't' || c == 'f') {
+				v.type = JsonValue::Type::BOOL;
+				v.boolean = c == 't';
+				return Literal(v.boolean ? "true" : "false");
+			}
+			if (c == 'n') {
+				v.type = JsonValue::Type::NUL;
+				return Literal("null");
+			}
+			char* end = nullptr;
+			v.type = JsonValue::Type::NUMBER;
+			v.number = strtod(s.c_str() + pos, &end);
+			if (end == s.c_str() + pos) return Fail("unexpected token");
+			pos = static_cast<size_t>(end - s.c_str());
+			return true;
+		}
+
+		const std::string& s;
+		size_t pos = 0;
+		const char* error = "";
+	};
+
+	// --- metryki ---
+	struct MetricRule {
+		const char* name;
+		bool higherIsBetter;
+		double threshold; // dopuszczalne pogorszenie mediany, ułamek
+	};
+
+	// Percentyle ogona są głośniejsze niż mediana, więc mają luźniejsze progi. Alokacje są
+	// deterministyczne: każdy wzrost to regresja. Metryk spoza tabeli (min/max, peak_*) nie porównujemy.
+	MetricRule g_rules[] = {
+		{ "ns_per_entity",     false, 0.10 },
+		{ "p90_ns",            false, 0.15 },
+		{ "p99_ns",            false, 0.25 },
+		{ "ticks_per_sec",     true,  0.10 },
+		{ "p50_ms",            false, 0.10 },
+		{ "p90_ms",            false, 0.15 },
+		{ "p99_ms",            false, 0.25 },
+		{ "allocations",       false, 0.0 },
+		{ "setup_allocations", false, 0.0 },
+		{ "max_asteroids",     true,  0.10 },
+		{ "max_projectiles",   true,  0.10 },
+	};
+
+	constexpr double C_MAD_TO_SIGMA = 1.4826; // MAD -> odchylenie standardowe dla rozkładu normalnego
+
+	// name -> metryka -> wartości kolejnych powtórzeń
+	using Samples = std::map<std::string, std::map<std::string, std::vector<double>>>;
+
+	struct BenchFile {
+		std::string suite;
+		std::string kernels;
+		Samples samples;
+		std::vector<std::string> order; // kolejność benchmarków jak w pliku
+	};
+
+	bool LoadResults(const char* path, BenchFile& out) {
+		FILE* f = fopen(path, "rb");
+		if (!f) {
+			fprintf(stderr, "%s: cannot open\n", path);
+			return false;
+		}
+		std::string text;
+		char buf[4096];
+		size_t n;
+		while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+		fclose(f);
+
+		JsonValue root;
+		JsonParser parser(text);
+		if (!parser.Parse(root)) {
+			fprintf(stderr, "%s: invalid JSON at offset %zu: %s\n", path, parser.Offset(), parser.Error());
+			return false;
+		}
+		const JsonValue* results = root.Find("results");
+		if (root.type != JsonValue::Type::OBJECT || !results || results->type != JsonValue::Type::ARRAY) {
+			fprintf(stderr, "%s: not a benchmark result file (no \"results\" array)\n", path);
+			return false;
+		}
+		if (const JsonValue* v = root.Find("suite")) out.suite = v->string;
+		if (const JsonValue* v = root.Find("kernels")) out.kernels = v->string;
+
+		for (const JsonValue& r : results->items) {
+			const JsonValue* name = r.Find("name");
+			if (!name || name->type != JsonValue::Type::STRING) {
+				fprintf(stderr, "%s: result without a name\n", path);
+				return false;
+			}
+			auto& metrics = out.samples[name->string];
+			if (metrics.empty()) out.order.push_back(name->string);
+			for (const MetricRule& rule : g_rules) {
+				const JsonValue* v = r.Find(rule.name);
+				if (v && v->type == JsonValue::Type::NUMBER) metrics[rule.name].push_back(v->number);
+			}
+		}
+		return true;
+	}
+
+	double Median(std::vector<double> v) {
+		if (v.empty()) return 0.0;
+		std::sort(v.begin(), v.end());
+		size_t h = v.size() / 2;
+		return v.size() % 2 ? v[h] : 0.5 * (v[h - 1] + v[h]);
+	}
+
+	double Mad(const std::vector<double>& v, double median) {
+		std::vector<double> dev(v.size());
+		for (size_t i = 0; i < v.size(); ++i) dev[i] = fabs(v[i] - median);
+		return Median(dev);
+	}
+
+	bool SetThreshold(const char* spec) {
+		const char* eq = strchr(spec, '=');
+		if (!eq) return false;
+		std::string name(spec, eq);
+		for (MetricRule& rule : g_rules) {
+			if (name == rule.name) {
+				char* end = nullptr;
+				double pct = strtod(eq + 1, &end);
+				if (end == eq + 1 || *end != '\0' || pct < 0.0) return false;
+				rule.threshold = pct / 100.0;
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+// Uruchomienie: asteroids_bench_compare baseline.json candidate.json [--threshold metryka=PROCENT]... [--noise K]
+int main(int argc, char** argv) {
+	std::vector<const char*> paths;
+	double noiseK = 3.0;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+			if (!SetThreshold(argv[++i])) {
+				fprintf(stderr, "invalid threshold '%s' (expected metric=percent)\n", argv[i]);
+				return 2;
+			}
+		}
+		else if (strcmp(argv[i], "--noise") == 0 && i + 1 < argc) noiseK = atof(argv[++i]);
+		else paths.push_back(argv[i]);
+	}
+	if (paths.size() != 2) {
+		fprintf(stderr, "usage: asteroids_bench_compare baseline.json candidate.json [--threshold metric=percent]... [--noise K]\n");
+		return 2;
+	}
+
+	BenchFile base, cand;
+	if (!LoadResults(paths[0], base) || !LoadResults(paths[1], cand)) return 2;
+	if (base.suite != cand.suite) {
+		fprintf(stderr, "suites differ: '%s' vs '%s'\n", base.suite.c_str(), cand.suite.c_str());
+		return 2;
+	}
+	if (base.kernels != cand.kernels) {
+		printf("warning: kernels differ (%s vs %s)\n", base.kernels.c_str(), cand.kernels.c_str());
+	}
+
+	printf("%-32s %-18s %14s %14s %9s %8s  %s\n", "benchmark", "metric", "baseline", "candidate", "change", "noise", "status");
+	int regressions = 0, improvements = 0;
+	for (const std::string& name : base.order) {
+		auto candIt = cand.samples.find(name);
+		if (candIt == cand.samples.end()) {
+			printf("%-32s %-18s %14s %14s %9s %8s  %s\n", name.c_str(), "-", "", "", "", "", "missing in candidate");
+			continue;
+		}
+		for (const MetricRule& rule : g_rules) {
+			auto b = base.samples[name].find(rule.name);
+			auto c = candIt->second.find(rule.name);
+			if (b == base.samples[name].end() || c == candIt->second.end()) continue;
+
+			const double mb = Median(b->second), mc = Median(c->second);
+			const double noise = C_MAD_TO_SIGMA * (Mad(b->second, mb) + Mad(c->second, mc));
+			// Dodatnia = gorzej, niezależnie od kierunku metryki
+			double worse = 0.0;
+			if (mb != 0.0) worse = (rule.higherIsBetter ? mb - mc : mc - mb) / fabs(mb);
+			else if (mc != mb) worse = (rule.higherIsBetter ? mc < mb : mc > mb) ? HUGE_VAL : -HUGE_VAL;
+			const bool significant = fabs(mc - mb) > noiseK * noise;
+
+			const char* status = "ok";
+			if (worse > rule.threshold) {
+				if (significant) {
+					status = "REGRESSION";
+					regressions++;
+				}
+				else {
+					status = "noisy";
+				}
+			}
+			else if (-worse > rule.threshold && significant) {
+				status = "improved";
+				improvements++;
+			}
+			const double change = mb != 0.0 ? (mc - mb) / fabs(mb) * 100.0 : 0.0;
+			const double noisePct = mb != 0.0 ? noise / fabs(mb) * 100.0 : 0.0;
+			printf("%-32s %-18s %14.4f %14.4f %+8.1f%% %7.1f%%  %s\n", name.c_str(), rule.name, mb, mc, change, noisePct, status);
+		}
+	}
+	for (const std::string& name : cand.order) {
+		if (base.samples.find(name) == base.samples.end()) {
+			printf("%-32s %-18s %14s %14s %9s %8s  %s\n", name.c_str(), "-", "", "", "", "", "new in candidate");
+		}
+	}
+
+	printf("%d regression(s), %d improvement(s)\n", regressions, improvements);
+	return regressions ? 1 : 0;
+}
@@ -0,0 +1,276 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <vector>
+
+#include "AabbTree.h"
+#include "AsteroidStore.h"
+#include "Broadphase.h"
+#include "Game.h"
+#include "Random.h"
+#include "SimdKernels.h"
+
+// Porównanie broadphase (siatka, sweep-and-prune, drzewo AABB, brute force) na powtarzalnych
+// scenach: asteroidy z AsteroidStore::Spawn (lecą do środka ekranu, rozłożone w czasie lotu)
+// i pociski lecące wzdłuż jednej osi, jak przy ShootDir. Sceny "mixed" dokładają BigAsteroid
+// (64 px) i zapytania o promieniu wybuchu SPECIAL (250 px) między pociskami 2 px.
+// Każda metoda musi dać te same trafienia.
+// --validate-tree: losowe sekwencje tworzenia, ruchu i usuwania proxy w AabbTree, po każdym
+// kroku zapytania porównane z brute force po tłustych pudełkach i kontrola struktury drzewa.
+
+namespace {
+	struct Scenario {
+		uint64_t seed;
+		size_t asteroids;
+		size_t projectiles;
+		bool mixed;
+	};
+
+	struct Result {
+		double msPerFrame = 0.0;
+		double candidatesPerQuery = 0.0;
+		uint64_t hits = 0;
+	};
+
+	constexpr int C_FRAMES = 240;
+	constexpr float C_DT = Game::C_TICK_DT;
+	constexpr float C_PROJECTILE_SPEED = 720.f;
+	constexpr int C_MIXED_BIG_EVERY = 20;        // co 20. asteroida to BigAsteroid
+	constexpr size_t C_MIXED_BLAST_EVERY = 100;  // co 100. zapytanie ma promień wybuchu
+	constexpr float C_BLAST_RADIUS = 250.f;
+
+	Result Run(const Scenario& sc, BroadphaseKind kind) {
+		Rng rng;
+		rng.Seed(sc.seed, 1);
+		AsteroidStore a;
+		a.Reserve(sc.asteroids + 1);
+		for (size_t i = 0; i < sc.asteroids; ++i) {
+			size_t id = sc.mixed && i % C_MIXED_BIG_EVERY == 0
+				? a.SpawnBig(Game::C_WIDTH, Game::C_HEIGHT, rng)
+				: a.Spawn(AsteroidShape::RANDOM, Game::C_WIDTH, Game::C_HEIGHT, rng);
+			// Rozrzuć w czasie lotu (0-4 s), żeby scena nie zaczynała się pusta
+			float t = rng.Float(0.f, 4.f);
+			a.posX[id] += a.velX[id] * t;
+			a.posY[id] += a.velY[id] * t;
+		}
+		std::vector<float> px(sc.projectiles), py(sc.projectiles), vx(sc.projectiles, 0.f), vy(sc.projectiles, -C_PROJECTILE_SPEED);
+		for (size_t i = 0; i < sc.projectiles; ++i) {
+			px[i] = rng.Float(0.f, static_cast<float>(Game::C_WIDTH));
+			py[i] = rng.Float(0.f, static_cast<float>(Game::C_HEIGHT));
+		}
+
+		Broadphase bp;
+		bp.Reset(Game::C_WIDTH, Game::C_HEIGHT, Game::C_GRID_CELL);
+		bp.SetKind(kind);
+		std::vector<int> candidates;
+		candidates.reserve(sc.asteroids);
+		std::vector<float> cx, cy, cr;
+		std::vector<char> hit(sc.asteroids);
+		std::vector<char> dead(std::max(sc.asteroids, sc.projectiles)); // maska wylotu, tu nieużywana
+
+		Result res;
+		uint64_t queries = 0, candidateCount = 0;
+		double seconds = 0.0;
+		for (int f = 0; f < C_FRAMES; ++f) {
+			IntegrateMarkOutOfBounds(a.posX.data(), a.posY.data(), a.velX.data(), a.velY.data(), a.radius.data(),
+				a.Size(), C_DT, Game::C_WIDTH, Game::C_HEIGHT, dead.data());
+			IntegrateMarkOutOfBounds(px.data(), py.data(), vx.data(), vy.data(), nullptr,
+				px.size(), C_DT, Game::C_WIDTH, Game::C_HEIGHT, dead.data());
+			// Pociski, które wyleciały górą, wracają na dół ekranu
+			for (size_t i = 0; i < py.size(); ++i) {
+				if (py[i] < 0.f) py[i] += Game::C_HEIGHT;
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			bp.Build(a);
+			for (size_t i = 0; i < px.size(); ++i) {
+				float r = sc.mixed && i % C_MIXED_BLAST_EVERY == 0 ? C_BLAST_RADIUS : 2.f;
+				bp.Query({ px[i], py[i] }, r, candidates);
+				cx.clear(); cy.clear(); cr.clear();
+				for (int ai : candidates) {
+					cx.push_back(a.posX[ai]); cy.push_back(a.posY[ai]); cr.push_back(a.radius[ai]);
+				}
+				res.hits += CircleOverlapMask(px[i], py[i], r, cx.data(), cy.data(), cr.data(), candidates.size(), hit.data());
+				candidateCount += candidates.size();
+				queries++;
+			}
+			seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+		res.msPerFrame = seconds * 1000.0 / C_FRAMES;
+		res.candidatesPerQuery = queries ? static_cast<double>(candidateCount) / queries : 0.0;
+		return res;
+	}
+
+	// Ten sam test co w AabbTree::QueryRay: pudełko odcinka i slab na pudełku powiększonym o radius
+	bool SegmentHits(const Aabb& b, Vector2 p0, Vector2 p1, float radius) {
+		const Aabb sweep = Aabb{ std::min(p0.x, p1.x), std::min(p0.y, p1.y), std::max(p0.x, p1.x), std::max(p0.y, p1.y) }.Expanded(radius);
+		if (!b.Overlaps(sweep)) return false;
+		float t0 = 0.f, t1 = 1.f;
+		const float lo[2] = { b.minX - radius, b.minY - radius };
+		const float hi[2] = { b.maxX + radius, b.maxY + radius };
+		const float p[2] = { p0.x, p0.y };
+		const float v[2] = { p1.x - p0.x, p1.y - p0.y };
+		for (int axis = 0; axis < 2; ++axis) {
+			if (fabsf(v[axis]) < 1e-12f) {
+				if (p[axis] < lo[axis] || p[axis] > hi[axis]) return false;
+				continue;
+			}
+			float inv = 1.f / v[axis];
+			float ta = (lo[axis] - p[axis]) * inv;
+			float tb = (hi[axis] - p[axis]) * inv;
+			if (ta > tb) std::swap(ta, tb);
+			t0 = std::max(t0, ta);
+			t1 = std::min(t1, tb);
+			if (t0 > t1) return false;
+		}
+		return true;
+	}
+
+	// Losowa sekwencja operacji na drzewie; zwraca liczbę rozbieżności z brute force
+	int ValidateTree(uint64_t seed, int steps) {
+		constexpr size_t C_MAX_PROXIES = 2000;
+		constexpr int C_PAIRS_EVERY = 50; // QueryPairs i Validate są O(n log n) / O(n)
+		struct Proxy {
+			int proxy;
+			int id;
+			Vector2 c;
+			float r;
+		};
+
+		Rng rng;
+		rng.Seed(seed, 7);
+		AabbTree tree;
+		std::vector<Proxy> live;
+		int nextId = 0;
+		auto randomCircle = [&](Proxy& p) {
+			p.c = { rng.Float(-100.f, Game::C_WIDTH + 100.f), rng.Float(-100.f, Game::C_HEIGHT + 100.f) };
+			p.r = rng.Int(0, 19) == 0 ? AsteroidStore::C_MAX_RADIUS : rng.Float(1.f, 32.f);
+		};
+
+		std::vector<int> got, want;
+		std::vector<std::pair<int, int>> gotPairs, wantPairs;
+		int failures = 0;
+		auto report = [&](int step, const char* what) {
+			if (failures++ < 10) fprintf(stderr, "tree validate: step %d: %s mismatch (%zu proxies)\n", step, what, live.size());
+		};
+
+		for (int step = 0; step < steps; ++step) {
+			const int op = rng.Int(0, 9);
+			if ((op < 3 || live.empty()) && live.size() < C_MAX_PROXIES) {
+				Proxy p{};
+				randomCircle(p);
+				p.id = nextId++;
+				p.proxy = tree.CreateProxy(Aabb::FromCircle(p.c, p.r), p.id);
+				live.push_back(p);
+			}
+			else if (op < 5 && !live.empty()) {
+				size_t i = static_cast<size_t>(rng.Int(0, static_cast<int>(live.size()) - 1));
+				tree.DestroyProxy(live[i].proxy);
+				live[i] = live.back();
+				live.pop_back();
+			}
+			else if (!live.empty()) {
+				// Większość ruchów mieści się w tłustym pudełku, część to skoki przez cały ekran
+				Proxy& p = live[static_cast<size_t>(rng.Int(0, static_cast<int>(live.size()) - 1))];
+				if (rng.Int(0, 9) == 0) {
+					randomCircle(p);
+				}
+				else {
+					p.c.x += rng.Float(-12.f, 12.f);
+					p.c.y += rng.Float(-12.f, 12.f);
+				}
+				tree.MoveProxy(p.proxy, Aabb::FromCircle(p.c, p.r));
+			}
+
+			// Zapytanie o okrąg i o odcinek przeciw pełnemu przejrzeniu tłustych pudełek
+			const Vector2 c = { rng.Float(0.f, static_cast<float>(Game::C_WIDTH)), rng.Float(0.f, static_cast<float>(Game::C_HEIGHT)) };
+			const float r = rng.Float(1.f, 250.f);
+			const Vector2 p1 = { c.x + rng.Float(-300.f, 300.f), c.y + rng.Float(-300.f, 300.f) };
+			const float rayRadius = rng.Float(0.f, 18.f);
+			tree.QueryCircle(c, r, got);
+			want.clear();
+			for (const Proxy& p : live) {
+				if (tree.UserData(p.proxy) != p.id || !tree.FatAabb(p.proxy).Contains(Aabb::FromCircle(p.c, p.r))) {
+					report(step, "proxy box");
+					break;
+				}
+				if (tree.FatAabb(p.proxy).Overlaps(Aabb::FromCircle(c, r))) want.push_back(p.id);
+			}
+			std::sort(want.begin(), want.end());
+			if (got != want) report(step, "circle query");
+
+			tree.QueryRay(c, p1, rayRadius, got);
+			want.clear();
+			for (const Proxy& p : live) {
+				if (SegmentHits(tree.FatAabb(p.proxy), c, p1, rayRadius)) want.push_back(p.id);
+			}
+			std::sort(want.begin(), want.end());
+			if (got != want) report(step, "ray query");
+
+			if (step % C_PAIRS_EVERY == 0 || step + 1 == steps) {
+				if (tree.ProxyCount() != live.size() || !tree.Validate()) report(step, "structure");
+				tree.QueryPairs(gotPairs);
+				wantPairs.clear();
+				for (size_t i = 0; i < live.size(); ++i) {
+					for (size_t j = i + 1; j < live.size(); ++j) {
+						if (!tree.FatAabb(live[i].proxy).Overlaps(tree.FatAabb(live[j].proxy))) continue;
+						wantPairs.emplace_back(std::min(live[i].id, live[j].id), std::max(live[i].id, live[j].id));
+					}
+				}
+				std::sort(wantPairs.begin(), wantPairs.end());
+				if (gotPairs != wantPairs) report(step, "pair query");
+			}
+		}
+		printf("tree validate: seed %llu, %d steps, %zu proxies at end, height %d, %llu reinserts, %d mismatches\n",
+			static_cast<unsigned long long>(seed), steps, live.size(), tree.Height(),
+			static_cast<unsigned long long>(tree.Reinserts()), failures);
+		return failures;
+	}
+}
+
+// Uruchomienie: asteroids_bench_broadphase [--seed N] [--validate-tree KROKI]
+// --validate-tree tylko sprawdza drzewo AABB (bez pomiarów); kod wyjścia 1 przy rozbieżności.
+int main(int argc, char** argv) {
+	uint64_t seed = 1;
+	int validateSteps = 0;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "--validate-tree") == 0) validateSteps = std::max(1, atoi(argv[++i]));
+	}
+	if (validateSteps > 0) {
+		return ValidateTree(seed, validateSteps) ? 1 : 0;
+	}
+
+	const Scenario scenarios[] = {
+		{ seed, Game::MAX_AST, 200, false },
+		{ seed, Game::MAX_AST, 2000, false },
+		{ seed + 1, 1000, 2000, false },
+		{ seed + 2, 1000, 10000, false },
+		{ seed + 3, 1000, 2000, true },
+		{ seed + 4, 1000, 10000, true },
+	};
+	const BroadphaseKind kinds[] = { BroadphaseKind::BRUTE, BroadphaseKind::GRID, BroadphaseKind::SAP, BroadphaseKind::TREE };
+
+	printf("%-6s %-5s %10s %12s %12s %14s %10s %9s\n", "method", "scene", "asteroids", "projectiles", "ms/frame", "cand/query", "hits", "speedup");
+	int failures = 0;
+	for (const Scenario& sc : scenarios) {
+		Result brute;
+		for (BroadphaseKind k : kinds) {
+			Result r = Run(sc, k);
+			if (k == BroadphaseKind::BRUTE) brute = r;
+			printf("%-6s %-5s %10zu %12zu %12.4f %14.2f %10llu %8.1fx\n", BroadphaseName(k), sc.mixed ? "mixed" : "plain",
+				sc.asteroids, sc.projectiles,
+				r.msPerFrame, r.candidatesPerQuery, static_cast<unsigned long long>(r.hits),
+				r.msPerFrame > 0.0 ? brute.msPerFrame / r.msPerFrame : 0.0);
+			if (r.hits != brute.hits) {
+				fprintf(stderr, "%s: %llu hits, brute force: %llu\n", BroadphaseName(k),
+					static_cast<unsigned long long>(r.hits), static_cast<unsigned long long>(brute.hits));
+				failures++;
+			}
+		}
+	}
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,186 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "AsteroidStore.h"
+#include "BenchHarness.h"
+#include "Broadphase.h"
+#include "Collision.h"
+#include "Game.h"
+#include "ProjectilePool.h"
+#include "Random.h"
+#include "SimdKernels.h"
+
+// Mikrobenchmarki gorących ścieżek symulacji: ruch pocisków i asteroid, przebiegi kolizji
+// pocisk-asteroida i asteroida-statek, spawn i usuwanie. Sceny są powtarzalne (stały seed),
+// a każdy wynik to ns na encję i percentyle pojedynczych iteracji.
+
+namespace {
+	constexpr uint64_t C_SEED = 1;
+	constexpr float C_DT = Game::C_TICK_DT;
+	constexpr float C_PROJECTILE_SPEED = 720.f;
+	constexpr size_t C_SIZES[] = { 1'000, 10'000, 100'000 };
+	constexpr int C_DEAD_EVERY = 10; // przy usuwaniu ginie co 10. encja
+
+	std::string Name(const char* base, size_t n) {
+		return std::string(base) + "/" + std::to_string(n);
+	}
+
+	// Asteroidy ze Spawn rozrzucone w czasie lotu (0-4 s), jak w broadphase_bench
+	void FillAsteroids(AsteroidStore& a, size_t n, Rng& rng) {
+		a.Reserve(n);
+		for (size_t i = 0; i < n; ++i) {
+			size_t id = a.Spawn(AsteroidShape::RANDOM, Game::C_WIDTH, Game::C_HEIGHT, rng);
+			float t = rng.Float(0.f, 4.f);
+			a.posX[id] += a.velX[id] * t;
+			a.posY[id] += a.velY[id] * t;
+		}
+	}
+
+	// Pociski w losowych miejscach ekranu, lecące w górę; co piąty to PLASMA
+	void FillProjectiles(ProjectilePool& p, size_t n, Rng& rng) {
+		for (size_t i = 0; i < n; ++i) {
+			Vector2 pos = { rng.Float(0.f, static_cast<float>(Game::C_WIDTH)), rng.Float(0.f, static_cast<float>(Game::C_HEIGHT)) };
+			WeaponType wt = i % 5 == 0 ? WeaponType::PLASMA : WeaponType::LASER;
+			p.Acquire(Projectile(pos, { 0.f, -C_PROJECTILE_SPEED }, GetWeaponStats(wt).damage, wt));
+		}
+	}
+
+	void BenchIntegrate(const BenchOptions& opt, std::vector<BenchResult>& out) {
+		for (size_t n : C_SIZES) {
+			Rng rng(C_SEED, 1);
+			ProjectilePool pool(n);
+			FillProjectiles(pool, n, rng);
+			std::vector<char> dead;
+			dead.reserve(n);
+			// Pociski zawracają co iterację, więc scena nie wylatuje z ekranu
+			float dir = 1.f;
+			RunBench(opt, Name("integrate_projectiles", n), n, [&] { dir = -dir; },
+				[&] { pool.Integrate(C_DT * dir, Game::C_WIDTH, Game::C_HEIGHT, dead); }, out);
+
+			AsteroidStore a;
+			FillAsteroids(a, n, rng);
+			RunBench(opt, Name("integrate_asteroids", n), n, [&] { dir = -dir; },
+				[&] { a.Integrate(C_DT * dir, Game::C_WIDTH, Game::C_HEIGHT, dead); }, out);
+		}
+	}
+
+	// Pełny przebieg pocisk-asteroida z Game::Step: budowa broadphase i CCD po TOI
+	void BenchProjectileHits(const BenchOptions& opt, std::vector<BenchResult>& out) {
+		const size_t projectileCounts[] = { 1'000, 10'000 };
+		const BroadphaseKind kinds[] = { BroadphaseKind::GRID, BroadphaseKind::SAP, BroadphaseKind::TREE };
+		for (size_t n : projectileCounts) {
+			Rng rng(C_SEED, 2);
+			AsteroidStore a;
+			FillAsteroids(a, Game::C_MAX_ASTEROIDS, rng);
+			ProjectilePool pool(n);
+			FillProjectiles(pool, n, rng);
+			std::vector<char> asteroidDead(a.Size(), 0);
+			CollisionQuery collision;
+			collision.Reserve(a.Size(), n);
+			std::vector<HitEvent> hits;
+			hits.reserve(n);
+
+			for (BroadphaseKind k : kinds) {
+				Broadphase bp;
+				bp.Reset(Game::C_WIDTH, Game::C_HEIGHT, Game::C_GRID_CELL);
+				bp.SetKind(k);
+				std::string name = std::string("projectile_hits_") + BroadphaseName(k);
+				RunBench(opt, Name(name.c_str(), n), n, [] {}, [&] {
+					bp.Build(a);
+					collision.ProjectileHits(pool, a, bp, asteroidDead, C_DT, hits);
+				}, out);
+			}
+		}
+	}
+
+	// Przebieg asteroida-statek: jedno zapytanie o okrąg statku w gotowym broadphase
+	void BenchShipHits(const BenchOptions& opt, std::vector<BenchResult>& out) {
+		for (size_t n : C_SIZES) {
+			Rng rng(C_SEED, 3);
+			AsteroidStore a;
+			FillAsteroids(a, n, rng);
+			std::vector<char> asteroidDead(a.Size(), 0);
+			Broadphase bp;
+			bp.Reset(Game::C_WIDTH, Game::C_HEIGHT, Game::C_GRID_CELL);
+			bp.Build(a);
+			CollisionQuery collision;
+			collision.Reserve(a.Size(), 0);
+			std::vector<int> hits;
+			hits.reserve(a.Size());
+			const Vector2 ship = { Game::C_WIDTH * 0.5f, Game::C_HEIGHT * 0.5f };
+			RunBench(opt, Name("ship_hits", n), n, [] {}, [&] {
+				collision.CircleHits(ship, Game::C_SHIP_RADIUS, a, bp, asteroidDead, hits);
+			}, out);
+		}
+	}
+
+	// Spawn N asteroid do pustego magazynu (bez alokacji - pojemność z Reserve)
+	void BenchSpawn(const BenchOptions& opt, std::vector<BenchResult>& out) {
+		for (size_t n : C_SIZES) {
+			Rng rng(C_SEED, 4);
+			AsteroidStore a;
+			a.Reserve(n);
+			RunBench(opt, Name("spawn_asteroids", n), n, [&] { a.Clear(); }, [&] {
+				for (size_t i = 0; i < n; ++i) a.Spawn(AsteroidShape::RANDOM, Game::C_WIDTH, Game::C_HEIGHT, rng);
+			}, out);
+		}
+	}
+
+	// SwapRemove z co 10. encją martwą; przed każdą iteracją scena wraca do stanu wyjściowego
+	// (przypisanie wektorów o wystarczającej pojemności nie alokuje)
+	void BenchRemove(const BenchOptions& opt, std::vector<BenchResult>& out) {
+		for (size_t n : C_SIZES) {
+			Rng rng(C_SEED, 5);
+			std::vector<char> deadTemplate(n, 0), dead;
+			for (size_t i = 0; i < n; i += C_DEAD_EVERY) deadTemplate[i] = 1;
+			dead.reserve(n);
+
+			AsteroidStore source, a;
+			FillAsteroids(source, n, rng);
+			a.Reserve(n);
+			RunBench(opt, Name("remove_asteroids", n), n, [&] { a = source; dead = deadTemplate; },
+				[&] { a.SwapRemove(dead); }, out);
+
+			ProjectilePool sourcePool(n), pool(n);
+			FillProjectiles(sourcePool, n, rng);
+			RunBench(opt, Name("remove_projectiles", n), n, [&] { pool = sourcePool; dead = deadTemplate; },
+				[&] { pool.SwapRemove(dead); }, out);
+		}
+	}
+}
+
+// Uruchomienie: asteroids_bench_micro [--filter PODCIĄG] [--min-time SEKUNDY] [--repeat N] [--json PLIK]
+int main(int argc, char** argv) {
+	BenchOptions opt;
+	const char* jsonPath = nullptr;
+	int repeat = 1;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (strcmp(argv[i], "--filter") == 0) opt.filter = argv[++i];
+		else if (strcmp(argv[i], "--min-time") == 0) opt.minTime = atof(argv[++i]);
+		else if (strcmp(argv[i], "--json") == 0) jsonPath = argv[++i];
+		else if (strcmp(argv[i], "--repeat") == 0) repeat = std::max(1, atoi(argv[++i]));
+	}
+
+	printf("kernels: %s\n", SimdKernelName());
+	std::vector<BenchResult> results;
+	// Powtórzenia całego zestawu, a nie każdego benchmarku z osobna: szum z innych procesów
+	// rozkłada się wtedy na wszystkie wyniki zamiast trafić w kilka kolejnych iteracji jednego
+	for (opt.run = 0; opt.run < repeat; ++opt.run) {
+		if (repeat > 1) printf("run %d/%d\n", opt.run + 1, repeat);
+		PrintBenchHeader();
+		BenchIntegrate(opt, results);
+		BenchProjectileHits(opt, results);
+		BenchShipHits(opt, results);
+		BenchSpawn(opt, results);
+		BenchRemove(opt, results);
+	}
+
+	if (jsonPath && !WriteBenchJson(jsonPath, "micro", SimdKernelName(), results)) {
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,159 @@
+﻿#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS // fopen
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "BenchHarness.h"
+#include "Game.h"
+#include "Scenario.h"
+#include "SimdKernels.h"
+
+// Benchmark makro: scenariusze z plików (scenarios/*.scn) grane bez okna i tekstur przez
+// zadaną liczbę ticków, tak szybko jak pozwala CPU. Wynik: ticki/s, percentyle czasu ticku,
+// szczytowa liczba encji i alokacje sterty po rozgrzewce. Każda alokacja w ustalonej grze to
+// regresja i kończy program kodem 1. Kolumna "hit cap" liczy trafienia odcięte limitem na pocisk.
+
+namespace {
+	constexpr long long C_WARMUP_TICKS = static_cast<long long>(Game::C_TICK_RATE); // 1 s gry
+
+	struct ScenarioResult {
+		std::string name;
+		int run = 0;
+		long long ticks = 0;
+		double ticksPerSecond = 0.0;
+		double p50Ms = 0.0, p90Ms = 0.0, p99Ms = 0.0, maxMs = 0.0;
+		size_t peakAsteroids = 0;
+		size_t peakProjectiles = 0;
+		uint64_t setupAllocations = 0; // Game i jego pule
+		uint64_t allocations = 0;      // po rozgrzewce
+		uint64_t droppedHits = 0;      // trafienia ponad CollisionQuery::C_MAX_HITS_PER_PROJECTILE
+		uint64_t hash = 0;
+	};
+
+	ScenarioResult Run(const Scenario& sc, long long ticks) {
+		using Clock = std::chrono::steady_clock;
+		ScenarioResult r;
+		r.name = sc.name;
+		std::vector<double> tickMs;
+		tickMs.reserve(static_cast<size_t>(ticks));
+
+		const uint64_t beforeSetup = HeapAllocations();
+		Game game(sc.seed, sc.game);
+		game.SetBroadphase(sc.broadphase);
+		const uint64_t beforeRun = HeapAllocations();
+		r.setupAllocations = beforeRun - beforeSetup;
+		uint64_t afterWarmup = beforeRun;
+
+		auto start = Clock::now();
+		long long tick = 0;
+		for (; tick < ticks && !game.IsEnded(); ++tick) {
+			InputState in = ScenarioInput(sc, game);
+			auto t0 = Clock::now();
+			game.Step(in, Game::C_TICK_DT);
+			tickMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+			r.peakAsteroids = std::max(r.peakAsteroids, game.GetAsteroids().Size());
+			r.peakProjectiles = std::max(r.peakProjectiles, game.GetProjectiles().size());
+			if (tick + 1 == C_WARMUP_TICKS) afterWarmup = HeapAllocations();
+		}
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		r.allocations = HeapAllocations() - afterWarmup;
+
+		r.ticks = tick;
+		r.ticksPerSecond = seconds > 0.0 ? tick / seconds : 0.0;
+		if (!tickMs.empty()) {
+			r.maxMs = *std::max_element(tickMs.begin(), tickMs.end());
+			r.p50Ms = Percentile(tickMs, 0.50);
+			r.p90Ms = Percentile(tickMs, 0.90);
+			r.p99Ms = Percentile(tickMs, 0.99);
+		}
+		r.droppedHits = game.GetDroppedHits();
+		r.hash = game.StateHash();
+		return r;
+	}
+
+	bool WriteJson(const char* path, const std::vector<ScenarioResult>& results) {
+		FILE* f = fopen(path, "w");
+		if (!f) {
+			fprintf(stderr, "Cannot write benchmark results: %s\n", path);
+			return false;
+		}
+		fprintf(f, "{\n  \"suite\": \"scenario\",\n  \"kernels\": \"%s\",\n  \"results\": [\n", SimdKernelName());
+		for (size_t i = 0; i < results.size(); ++i) {
+			const ScenarioResult& r = results[i];
+			fprintf(f, "    {\"name\": \"%s\", \"run\": %d, \"ticks\": %lld, \"ticks_per_sec\": %.1f, \"p50_ms\": %.4f, \"p90_ms\": %.4f, "
+				"\"p99_ms\": %.4f, \"max_ms\": %.4f, \"peak_asteroids\": %zu, \"peak_projectiles\": %zu, "
+				"\"setup_allocations\": %llu, \"allocations\": %llu, \"dropped_hits\": %llu, \"state_hash\": \"%016llx\"}%s\n",
+				r.name.c_str(), r.run, r.ticks, r.ticksPerSecond, r.p50Ms, r.p90Ms, r.p99Ms, r.maxMs, r.peakAsteroids, r.peakProjectiles,
+				static_cast<unsigned long long>(r.setupAllocations), static_cast<unsigned long long>(r.allocations),
+				static_cast<unsigned long long>(r.droppedHits), static_cast<unsigned long long>(r.hash), i + 1 < results.size() ? "," : "");
+		}
+		fprintf(f, "  ]\n}\n");
+		bool ok = ferror(f) == 0;
+		if (fclose(f) != 0) ok = false;
+		if (!ok) fprintf(stderr, "Cannot write benchmark results: %s\n", path);
+		return ok;
+	}
+}
+
+// Uruchomienie: asteroids_bench_scenario [--ticks N] [--repeat N] [--json PLIK] scenariusz.scn...
+// --ticks nadpisuje długość ze wszystkich scenariuszy.
+int main(int argc, char** argv) {
+	long long ticksOverride = 0;
+	int repeat = 1;
+	const char* jsonPath = nullptr;
+	std::vector<const char*> paths;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticksOverride = atoll(argv[++i]);
+		else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+		else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeat = std::max(1, atoi(argv[++i]));
+		else paths.push_back(argv[i]);
+	}
+	if (paths.empty()) {
+		fprintf(stderr, "usage: asteroids_bench_scenario [--ticks N] [--repeat N] [--json file] scenario.scn...\n");
+		return 1;
+	}
+
+	// Najpierw wszystkie pliki, żeby błąd w ostatnim nie wyszedł po kilku minutach pomiarów
+	std::vector<Scenario> scenarios(paths.size());
+	for (size_t i = 0; i < paths.size(); ++i) {
+		if (!LoadScenario(paths[i], scenarios[i])) return 1;
+	}
+
+	printf("kernels: %s\n", SimdKernelName());
+	printf("%-24s %8s %10s %9s %9s %9s %9s %9s %9s %7s %8s\n", "scenario", "ticks", "ticks/s", "p50 ms", "p90 ms", "p99 ms", "max ms",
+		"peak ast", "peak proj", "allocs", "hit cap");
+	std::vector<ScenarioResult> results;
+	bool allocationFree = true;
+	for (int run = 0; run < repeat; ++run) {
+		for (const Scenario& sc : scenarios) {
+			ScenarioResult r = Run(sc, ticksOverride > 0 ? ticksOverride : sc.ticks);
+			r.run = run;
+			printf("%-24s %8lld %10.0f %9.4f %9.4f %9.4f %9.4f %9zu %9zu %7llu %8llu\n", r.name.c_str(), r.ticks, r.ticksPerSecond,
+				r.p50Ms, r.p90Ms, r.p99Ms, r.maxMs, r.peakAsteroids, r.peakProjectiles, static_cast<unsigned long long>(r.allocations),
+				static_cast<unsigned long long>(r.droppedHits));
+			fflush(stdout);
+			if (r.allocations > 0) allocationFree = false;
+			if (r.droppedHits > 0) {
+				fprintf(stderr, "%s: %llu hits over the per-projectile cap (%zu) were delayed or lost\n", r.name.c_str(),
+					static_cast<unsigned long long>(r.droppedHits), CollisionQuery::C_MAX_HITS_PER_PROJECTILE);
+			}
+			results.push_back(r);
+		}
+	}
+
+	if (jsonPath && !WriteJson(jsonPath, results)) {
+		return 1;
+	}
+	if (!allocationFree) {
+		fprintf(stderr, "heap allocations after warm-up (%lld ticks) in steady-state play\n", C_WARMUP_TICKS);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,329 @@
+﻿#include "AabbTree.h"
+
+#include <cmath>
+
+void AabbTree::Clear() {
+	nodes.clear();
+	root = C_NULL;
+	freeList = C_NULL;
+	proxyCount = 0;
+}
+
+int AabbTree::AllocateNode() {
+	if (freeList == C_NULL) {
+		nodes.emplace_back();
+		return static_cast<int>(nodes.size()) - 1;
+	}
+	int id = freeList;
+	freeList = nodes[id].parent;
+	nodes[id] = Node{};
+	return id;
+}
+
+void AabbTree::FreeNode(int id) {
+	nodes[id].parent = freeList;
+	nodes[id].height = -1;
+	freeList = id;
+}
+
+int AabbTree::CreateProxy(const Aabb& box, int userData) {
+	int leaf = AllocateNode();
+	nodes[leaf].box = box.Expanded(margin);
+	nodes[leaf].userData = userData;
+	nodes[leaf].height = 0;
+	InsertLeaf(leaf);
+	proxyCount++;
+	return leaf;
+}
+
+void AabbTree::DestroyProxy(int proxy) {
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	proxyCount--;
+}
+
+bool AabbTree::MoveProxy(int proxy, const Aabb& box) {
+	if (nodes[proxy].box.Contains(box)) return false;
+	RemoveLeaf(proxy);
+	nodes[proxy].box = box.Expanded(margin);
+	InsertLeaf(proxy);
+	reinserts++;
+	return true;
+}
+
+void AabbTree::Refit(int index) {
+	while (index != C_NULL) {
+		index = Balance(index);
+		Node& n = nodes[index];
+		n.height = 1 + std::max(nodes[n.child1].height, nodes[n.child2].height);
+		n.box = nodes[n.child1].box.Union(nodes[n.child2].box);
+		index = n.parent;
+	}
+}
+
+void AabbTree::InsertLeaf(int leaf) {
+	if (root == C_NULL) {
+		root = leaf;
+		nodes[root].parent = C_NULL;
+		return;
+	}
+
+	// Zejście do rodzeństwa o najmniejszym przyroście obwodu
+	const Aabb leafBox = nodes[leaf].box;
+	int index = root;
+	while (!nodes[index].IsLeaf()) {
+		const Node& n = nodes[index];
+		float area = n.box.Perimeter();
+		float combinedArea = n.box.Union(leafBox).Perimeter();
+		float cost = 2.f * combinedArea;              // nowy rodzic dla tego węzła i liścia
+		float inheritance = 2.f * (combinedArea - area); // przyrost, który zapłacą przodkowie
+
+		auto descendCost = [&](int child) {
+			const Node& c = nodes[child];
+			float grown = leafBox.Union(c.box).Perimeter();
+			return (c.IsLeaf() ? grown : grown - c.box.Perimeter()) + inheritance;
+		};
+		float cost1 = descendCost(n.child1);
+		float cost2 = descendCost(n.child2);
+		if (cost < cost1 && cost < cost2) break;
+		index = cost1 < cost2 ? n.child1 : n.child2;
+	}
+	int sibling = index;
+
+	int oldParent = nodes[sibling].parent;
+	int newParent = AllocateNode(); // może przenieść nodes - bez referencji przed tym miejscem
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].box = leafBox.Union(nodes[sibling].box);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+	if (oldParent != C_NULL) {
+		if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+		else nodes[oldParent].child2 = newParent;
+	}
+	else {
+		root = newParent;
+	}
+
+	Refit(nodes[leaf].parent);
+}
+
+void AabbTree::RemoveLeaf(int leaf) {
+	if (leaf == root) {
+		root = C_NULL;
+		return;
+	}
+	int parent = nodes[leaf].parent;
+	int grandParent = nodes[parent].parent;
+	int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent != C_NULL) {
+		if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+		else nodes[grandParent].child2 = sibling;
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+		Refit(grandParent);
+	}
+	else {
+		root = sibling;
+		nodes[sibling].parent = C_NULL;
+		FreeNode(parent);
+	}
+}
+
+// Rotacja, jeśli wysokości poddrzew A różnią się o więcej niż 1. Zwraca nowy korzeń poddrzewa.
+int AabbTree::Balance(int iA) {
+	Node& A = nodes[iA];
+	if (A.IsLeaf() || A.height < 2) return iA;
+
+	int iB = A.child1;
+	int iC = A.child2;
+	Node& B = nodes[iB];
+	Node& C = nodes[iC];
+	int balance = C.height - B.height;
+
+	// C w górę
+	if (balance > 1) {
+		int iF = C.child1;
+		int iG = C.child2;
+		Node& F = nodes[iF];
+		Node& G = nodes[iG];
+
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+		if (C.parent != C_NULL) {
+			if (nodes[C.parent].child1 == iA) nodes[C.parent].child1 = iC;
+			else nodes[C.parent].child2 = iC;
+		}
+		else {
+			root = iC;
+		}
+
+		if (F.height > G.height) {
+			C.child2 = iF;
+			A.child2 = iG;
+			G.parent = iA;
+			A.box = B.box.Union(G.box);
+			C.box = A.box.Union(F.box);
+			A.height = 1 + std::max(B.height, G.height);
+			C.height = 1 + std::max(A.height, F.height);
+		}
+		else {
+			C.child2 = iG;
+			A.child2 = iF;
+			F.parent = iA;
+			A.box = B.box.Union(F.box);
+			C.box = A.box.Union(G.box);
+			A.height = 1 + std::max(B.height, F.height);
+			C.height = 1 + std::max(A.height, G.height);
+		}
+		return iC;
+	}
+
+	// B w górę
+	if (balance < -1) {
+		int iD = B.child1;
+		int iE = B.child2;
+		Node& D = nodes[iD];
+		Node& E = nodes[iE];
+
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+		if (B.parent != C_NULL) {
+			if (nodes[B.parent].child1 == iA) nodes[B.parent].child1 = iB;
+			else nodes[B.parent].child2 = iB;
+		}
+		else {
+			root = iB;
+		}
+
+		if (D.height > E.height) {
+			B.child2 = iD;
+			A.child1 = iE;
+			E.parent = iA;
+			A.box = C.box.Union(E.box);
+			B.box = A.box.Union(D.box);
+			A.height = 1 + std::max(C.height, E.height);
+			B.height = 1 + std::max(A.height, D.height);
+		}
+		else {
+			B.child2 = iE;
+			A.child1 = iD;
+			D.parent = iA;
+			A.box = C.box.Union(D.box);
+			B.box = A.box.Union(E.box);
+			A.height = 1 + std::max(C.height, D.height);
+			B.height = 1 + std::max(A.height, E.height);
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
+void AabbTree::QueryCircle(Vector2 c, float r, std::vector<int>& out) const {
+	out.clear();
+	Query(Aabb::FromCircle(c, r), [&out](int userData) { out.push_back(userData); });
+	if (out.size() > 1) std::sort(out.begin(), out.end());
+}
+
+void AabbTree::QueryRay(Vector2 p0, Vector2 p1, float radius, std::vector<int>& out) const {
+	out.clear();
+	if (root == C_NULL) return;
+	const Vector2 d = { p1.x - p0.x, p1.y - p0.y };
+	// Pudełko całego odcinka odrzuca większość drzewa zanim zaczną się testy slab
+	const Aabb sweep = Aabb{ std::min(p0.x, p1.x), std::min(p0.y, p1.y), std::max(p0.x, p1.x), std::max(p0.y, p1.y) }.Expanded(radius);
+
+	auto segmentHits = [&](const Aabb& b) {
+		// Test slab: odcinek p0 + t * d, t w [0, 1], przeciw pudełku powiększonemu o radius
+		float t0 = 0.f, t1 = 1.f;
+		const float lo[2] = { b.minX - radius, b.minY - radius };
+		const float hi[2] = { b.maxX + radius, b.maxY + radius };
+		const float p[2] = { p0.x, p0.y };
+		const float v[2] = { d.x, d.y };
+		for (int axis = 0; axis < 2; ++axis) {
+			if (fabsf(v[axis]) < 1e-12f) {
+				if (p[axis] < lo[axis] || p[axis] > hi[axis]) return false;
+				continue;
+			}
+			float inv = 1.f / v[axis];
+			float ta = (lo[axis] - p[axis]) * inv;
+			float tb = (hi[axis] - p[axis]) * inv;
+			if (ta > tb) std::swap(ta, tb);
+			t0 = std::max(t0, ta);
+			t1 = std::min(t1, tb);
+			if (t0 > t1) return false;
+		}
+		return true;
+	};
+
+	stack.clear();
+	stack.push_back(root);
+	while (!stack.empty()) {
+		int id = stack.back();
+		stack.pop_back();
+		const Node& n = nodes[id];
+		if (!n.box.Overlaps(sweep) || !segmentHits(n.box)) continue;
+		if (n.IsLeaf()) {
+			out.push_back(n.userData);
+		}
+		else {
+			stack.push_back(n.child1);
+			stack.push_back(n.child2);
+		}
+	}
+	if (out.size() > 1) std::sort(out.begin(), out.end());
+}
+
+void AabbTree::QueryPairs(std::vector<std::pair<int, int>>& out) const {
+	out.clear();
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		const Node& leaf = nodes[i];
+		if (leaf.height != 0) continue;
+		// Query używa wspólnego stosu, więc wyniki zbierane są przez callback bez zagnieżdżania
+		Query(leaf.box, [&](int other) {
+			if (leaf.userData < other) out.emplace_back(leaf.userData, other);
+		});
+	}
+	std::sort(out.begin(), out.end());
+}
+
+bool AabbTree::Validate() const {
+	size_t leaves = 0, reached = 0;
+	if (root != C_NULL) {
+		if (nodes[root].parent != C_NULL) return false;
+		stack.clear();
+		stack.push_back(root);
+		while (!stack.empty()) {
+			int id = stack.back();
+			stack.pop_back();
+			const Node& n = nodes[id];
+			reached++;
+			if (reached > nodes.size() || n.height < 0) return false; // cykl albo wolny węzeł w drzewie
+			if (n.IsLeaf()) {
+				if (n.height != 0 || n.child2 != C_NULL) return false;
+				leaves++;
+				continue;
+			}
+			const Node& a = nodes[n.child1];
+			const Node& b = nodes[n.child2];
+			if (a.parent != id || b.parent != id) return false;
+			if (n.height != 1 + std::max(a.height, b.height)) return false;
+			const Aabb u = a.box.Union(b.box);
+			if (n.box.minX != u.minX || n.box.minY != u.minY || n.box.maxX != u.maxX || n.box.maxY != u.maxY) return false;
+			stack.push_back(n.child1);
+			stack.push_back(n.child2);
+		}
+	}
+	if (leaves != proxyCount) return false;
+
+	size_t free = 0;
+	for (int id = freeList; id != C_NULL; id = nodes[id].parent) {
+		if (nodes[id].height != -1 || ++free > nodes.size()) return false;
+	}
+	return reached + free == nodes.size();
+}
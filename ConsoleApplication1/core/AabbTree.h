@@ -0,0 +1,147 @@
+﻿#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <raylib.h>
+
+// --- DYNAMIC AABB TREE ---
+struct Aabb {
+	float minX, minY, maxX, maxY;
+
+	static Aabb FromCircle(Vector2 c, float r) {
+		return { c.x - r, c.y - r, c.x + r, c.y + r };
+	}
+
+	bool Contains(const Aabb& o) const {
+		return minX <= o.minX && minY <= o.minY && o.maxX <= maxX && o.maxY <= maxY;
+	}
+
+	bool Overlaps(const Aabb& o) const {
+		return minX <= o.maxX && o.minX <= maxX && minY <= o.maxY && o.minY <= maxY;
+	}
+
+	Aabb Union(const Aabb& o) const {
+		return { std::min(minX, o.minX), std::min(minY, o.minY), std::max(maxX, o.maxX), std::max(maxY, o.maxY) };
+	}
+
+	Aabb Expanded(float m) const {
+		return { minX - m, minY - m, maxX + m, maxY + m };
+	}
+
+	float Perimeter() const {
+		return 2.f * ((maxX - minX) + (maxY - minY));
+	}
+};
+
+// Drzewo AABB z powiększonymi ("tłustymi") pudełkami liści, jak w Box2D. Ruch w obrębie
+// tłustego pudełka nic nie kosztuje; dopiero wyjście poza nie usuwa i wstawia liść od nowa
+// (wybór rodzeństwa po koszcie obwodu, balansowanie rotacjami AVL). Koszt zapytania zależy od
+// wysokości drzewa, a nie od rozmiarów obiektów, więc pociski 2 px i asteroidy 64 px nie
+// psują sobie nawzajem podziału jak w siatce o stałej komórce.
+// Proxy to indeks węzła-liścia; userData to id obiektu po stronie wywołującego.
+class AabbTree {
+public:
+	static constexpr int C_NULL = -1;
+
+	explicit AabbTree(float fatMargin = 8.f) : margin(fatMargin) {}
+
+	// Węzły i stos zapytań dla proxies liści; do tej liczby drzewo nie alokuje
+	void Reserve(size_t proxies) {
+		nodes.reserve(2 * proxies);
+		stack.reserve(2 * proxies);
+	}
+
+	void Clear();
+
+	int CreateProxy(const Aabb& box, int userData);
+	void DestroyProxy(int proxy);
+	// Nowe ścisłe pudełko; true, jeśli liść wyszedł poza tłuste pudełko i został wstawiony od nowa
+	bool MoveProxy(int proxy, const Aabb& box);
+
+	int UserData(int proxy) const {
+		return nodes[proxy].userData;
+	}
+
+	const Aabb& FatAabb(int proxy) const {
+		return nodes[proxy].box;
+	}
+
+	// callback(userData) dla każdego liścia, którego tłuste pudełko nachodzi na box
+	template <typename F>
+	void Query(const Aabb& box, F&& callback) const {
+		if (root == C_NULL) return;
+		stack.clear();
+		stack.push_back(root);
+		while (!stack.empty()) {
+			int id = stack.back();
+			stack.pop_back();
+			const Node& n = nodes[id];
+			if (!n.box.Overlaps(box)) continue;
+			if (n.IsLeaf()) {
+				callback(n.userData);
+			}
+			else {
+				stack.push_back(n.child1);
+				stack.push_back(n.child2);
+			}
+		}
+	}
+
+	// userData liści nachodzących na okrąg (po pudełkach), posortowane rosnąco
+	void QueryCircle(Vector2 c, float r, std::vector<int>& out) const;
+	// userData liści, które może trafić okrąg o promieniu radius przesuwany od p0 do p1, posortowane
+	void QueryRay(Vector2 p0, Vector2 p1, float radius, std::vector<int>& out) const;
+	// Wszystkie pary (a < b) userData liści o nachodzących tłustych pudełkach, posortowane
+	void QueryPairs(std::vector<std::pair<int, int>>& out) const;
+
+	int Height() const {
+		return root == C_NULL ? 0 : nodes[root].height;
+	}
+
+	size_t ProxyCount() const {
+		return proxyCount;
+	}
+
+	// Wstawienia liści od nowa od ostatniego ResetCounters (miara jakości marginesu)
+	size_t Reinserts() const {
+		return reinserts;
+	}
+
+	void ResetCounters() {
+		reinserts = 0;
+	}
+
+	// Spójność struktury: wskaźniki rodzic-dziecko, wysokości, pudełka węzłów równe sumie dzieci,
+	// liczba liści i wolnych węzłów. Koszt O(n) - do testów, nie do gry.
+	bool Validate() const;
+
+private:
+	struct Node {
+		Aabb box{};
+		int parent = C_NULL; // dla wolnego węzła: następny wolny
+		int child1 = C_NULL;
+		int child2 = C_NULL;
+		int height = -1;     // -1 wolny, 0 liść
+		int userData = -1;
+
+		bool IsLeaf() const {
+			return child1 == C_NULL;
+		}
+	};
+
+	int AllocateNode();
+	void FreeNode(int id);
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf);
+	int Balance(int iA);
+	void Refit(int index);
+
+	std::vector<Node> nodes;
+	int root = C_NULL;
+	int freeList = C_NULL;
+	float margin;
+	size_t proxyCount = 0;
+	size_t reinserts = 0;
+	mutable std::vector<int> stack;
+};
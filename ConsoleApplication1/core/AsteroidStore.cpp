@@ -0,0 +1,183 @@
+﻿#include "AsteroidStore.h"
+#include "SimdKernels.h"
+
+#include <cmath>
+
+#include <raylib.h>
+#include <raymath.h>
+
+
+namespace {
+	constexpr float SPEED_MIN = 125.f;
+	constexpr float SPEED_MAX = 250.f;
+	constexpr float ROT_MIN = 50.f;
+	constexpr float ROT_MAX = 240.f;
+	constexpr float BASE_RADIUS = 16.f; // promień rozmiaru 1; rozmiary 1, 2, 4
+
+	constexpr float BIG_RADIUS = 64.f; // Duży promień
+	constexpr float BIG_SPEED = 100.f;
+	constexpr int BIG_HP = 1000;
+	static_assert(BIG_RADIUS <= AsteroidStore::C_MAX_RADIUS && BASE_RADIUS * 4 <= AsteroidStore::C_MAX_RADIUS,
+		"broadphase reserves cells for C_MAX_RADIUS");
+
+	// Bazowe obrażenia kształtu, mnożone przez rozmiar (1, 2, 4)
+	int BaseDamage(AsteroidShape s) {
+		switch (s) {
+		case AsteroidShape::TRIANGLE: return 5;
+		case AsteroidShape::SQUARE:   return 10;
+		case AsteroidShape::PENTAGON: return 15;
+		case AsteroidShape::BIG:      return 30;
+		default:                      return 0;
+		}
+	}
+}
+
+void AsteroidStore::Reserve(size_t n) {
+	if (n > posX.capacity()) stats.allocations++;
+	stats.capacity = n;
+	posX.reserve(n); posY.reserve(n);
+	velX.reserve(n); velY.reserve(n);
+	rotation.reserve(n); rotationSpeed.reserve(n);
+	radius.reserve(n);
+	shape.reserve(n);
+	flags.reserve(n);
+	damage.reserve(n);
+	hp.reserve(n);
+}
+
+void AsteroidStore::Clear() {
+	stats.released += Size();
+	posX.clear(); posY.clear();
+	velX.clear(); velY.clear();
+	rotation.clear(); rotationSpeed.clear();
+	radius.clear();
+	shape.clear();
+	flags.clear();
+	damage.clear();
+	hp.clear();
+}
+
+size_t AsteroidStore::Push(float x, float y, float vx, float vy, float rot, float rotSpeed, float r, AsteroidShape s, int dmg, int hitPoints) {
+	if (Size() >= stats.capacity) {
+		stats.overflow++;
+		return npos;
+	}
+	posX.push_back(x); posY.push_back(y);
+	velX.push_back(vx); velY.push_back(vy);
+	rotation.push_back(rot); rotationSpeed.push_back(rotSpeed);
+	radius.push_back(r);
+	shape.push_back(s);
+	flags.push_back(s == AsteroidShape::BIG ? FLAG_BOSS : FLAG_NONE);
+	damage.push_back(dmg);
+	hp.push_back(hitPoints);
+	stats.spawned++;
+	if (Size() > stats.highWater) stats.highWater = Size();
+	return posX.size() - 1;
+}
+
+size_t AsteroidStore::Spawn(AsteroidShape s, int screenW, int screenH, Rng& rng) {
+	if (s == AsteroidShape::RANDOM || s == AsteroidShape::BIG) {
+		s = static_cast<AsteroidShape>(3 + rng.Int(0, 2));
+	}
+
+	// Choose size
+	int size = 1 << rng.Int(0, 2);
+	float r = BASE_RADIUS * static_cast<float>(size);
+
+	// Spawn at random edge
+	Vector2 pos;
+	switch (rng.Int(0, 3)) {
+	case 0:
+		pos = { rng.Float(0, static_cast<float>(screenW)), -r };
+		break;
+	case 1:
+		pos = { screenW + r, rng.Float(0, static_cast<float>(screenH)) };
+		break;
+	case 2:
+		pos = { rng.Float(0, static_cast<float>(screenW)), screenH + r };
+		break;
+	default:
+		pos = { -r, rng.Float(0, static_cast<float>(screenH)) };
+		break;
+	}
+
+	// Aim towards center with jitter
+	float maxOff = fminf(screenW, screenH) * 0.1f;
+	float ang = rng.Float(0, 2 * PI);
+	float rad = rng.Float(0, maxOff);
+	Vector2 center = {
+									 screenW * 0.5f + cosf(ang) * rad,
+									 screenH * 0.5f + sinf(ang) * rad
+	};
+
+	Vector2 dir = Vector2Normalize(Vector2Subtract(center, pos));
+	Vector2 vel = Vector2Scale(dir, rng.Float(SPEED_MIN, SPEED_MAX));
+	float rotSpeed = rng.Float(ROT_MIN, ROT_MAX);
+	float rot = rng.Float(0, 360);
+
+	// Zwykła asteroida ginie od pierwszego trafienia
+	return Push(pos.x, pos.y, vel.x, vel.y, rot, rotSpeed, r, s, BaseDamage(s) * size, 1);
+}
+
+size_t AsteroidStore::SpawnBig(int screenW, int screenH, Rng& rng) {
+	// Ustaw pozycję na górnej krawędzi
+	Vector2 pos = { rng.Float(0, static_cast<float>(screenW)), -BIG_RADIUS };
+	// Kierunek do środka ekranu
+	Vector2 center = { screenW * 0.5f, screenH * 0.5f };
+	Vector2 dir = Vector2Normalize(Vector2Subtract(center, pos));
+	Vector2 vel = Vector2Scale(dir, BIG_SPEED);
+	float rotSpeed = rng.Float(20.f, 60.f);
+	float rot = rng.Float(0, 360);
+
+	return Push(pos.x, pos.y, vel.x, vel.y, rot, rotSpeed, BIG_RADIUS, AsteroidShape::BIG,
+		BaseDamage(AsteroidShape::BIG) * 4, BIG_HP);
+}
+
+void AsteroidStore::Integrate(float dt, int screenW, int screenH, std::vector<char>& dead) {
+	const size_t n = Size();
+	IntegrateMarkOutOfBounds(posX.data(), posY.data(), velX.data(), velY.data(), radius.data(), n, dt,
+		static_cast<float>(screenW), static_cast<float>(screenH), dead.data());
+	for (size_t i = 0; i < n; ++i) {
+		rotation[i] += rotationSpeed[i] * dt;
+	}
+}
+
+void AsteroidStore::Move(size_t from, size_t to) {
+	posX[to] = posX[from]; posY[to] = posY[from];
+	velX[to] = velX[from]; velY[to] = velY[from];
+	rotation[to] = rotation[from]; rotationSpeed[to] = rotationSpeed[from];
+	radius[to] = radius[from];
+	shape[to] = shape[from];
+	flags[to] = flags[from];
+	damage[to] = damage[from];
+	hp[to] = hp[from];
+}
+
+void AsteroidStore::Resize(size_t n) {
+	posX.resize(n); posY.resize(n);
+	velX.resize(n); velY.resize(n);
+	rotation.resize(n); rotationSpeed.resize(n);
+	radius.resize(n);
+	shape.resize(n);
+	flags.resize(n);
+	damage.resize(n);
+	hp.resize(n);
+}
+
+void AsteroidStore::SwapRemove(std::vector<char>& dead) {
+	size_t n = Size();
+	for (size_t i = 0; i < n;) {
+		if (!dead[i]) {
+			++i;
+			continue;
+		}
+		// Ostatni element wskakuje na i i jest sprawdzany w kolejnym obrocie
+		--n;
+		if (i != n) {
+			Move(n, i);
+			dead[i] = dead[n];
+		}
+	}
+	stats.released += Size() - n;
+	Resize(n);
+}
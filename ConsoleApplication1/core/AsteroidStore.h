@@ -0,0 +1,74 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Components.h"
+#include "Random.h"
+
+// --- ASTEROIDS (SoA) ---
+
+// Shape selector. Wartość = liczba boków rysowanego wielokąta; BIG to BigAsteroid.
+enum class AsteroidShape : uint8_t { TRIANGLE = 3, SQUARE = 4, PENTAGON = 5, BIG = 8, RANDOM = 0 };
+
+// Wszystkie asteroidy w równoległych tablicach (structure-of-arrays). Asteroida to indeks,
+// a przebiegi integracji i kolizji czytają ciągłą pamięć bez wskaźników i wywołań wirtualnych.
+// Usuwanie to swap-and-pop raz na tick (SwapRemove), więc kolejność elementów nie jest stała.
+// Pojemność ustala Reserve() i jest twardym limitem (arena): Spawn przy pełnym magazynie
+// nie rośnie, tylko odrzuca asteroidę i zwraca npos, więc rozgrywka nie alokuje na stercie.
+struct AsteroidStore {
+	static constexpr size_t npos = static_cast<size_t>(-1);
+	static constexpr float C_MAX_RADIUS = 64.f; // BigAsteroid i największa zwykła (16 * 4)
+
+	struct Stats {
+		size_t capacity = 0;
+		size_t live = 0;
+		size_t highWater = 0;
+		uint64_t spawned = 0;
+		uint64_t released = 0;
+		uint64_t overflow = 0;    // odrzucone, bo magazyn był pełny
+		uint64_t allocations = 0; // ile razy tablice były (re)alokowane
+	};
+
+	std::vector<float> posX, posY;
+	std::vector<float> velX, velY;
+	std::vector<float> rotation, rotationSpeed;
+	std::vector<float> radius;
+	std::vector<AsteroidShape> shape;
+	std::vector<uint8_t> flags; // EntityFlag
+	std::vector<int> damage;
+	std::vector<int> hp;
+
+	size_t Size() const {
+		return posX.size();
+	}
+
+	// Alokuje wszystkie tablice na n asteroid; tylko tu powstają alokacje
+	void Reserve(size_t n);
+	void Clear();
+
+	// Nowa asteroida na losowej krawędzi ekranu, lecąca w okolice środka. RANDOM losuje kształt.
+	// Zwraca indeks albo npos, gdy magazyn jest pełny.
+	size_t Spawn(AsteroidShape s, int screenW, int screenH, Rng& rng);
+	// BigAsteroid: górna krawędź, prosto do środka, 1000 hp
+	size_t SpawnBig(int screenW, int screenH, Rng& rng);
+
+	// Ruch i obrót (kernel SIMD); ustawia dead[i] dla asteroid, które całkiem opuściły ekran
+	void Integrate(float dt, int screenW, int screenH, std::vector<char>& dead);
+	// Usuwa elementy z dead[i] != 0: na miejsce martwego trafia ostatni element (O(1) na usunięcie).
+	// dead jest przestawiane razem z danymi i po wywołaniu nie odpowiada już indeksom.
+	void SwapRemove(std::vector<char>& dead);
+
+	Stats GetStats() const {
+		Stats s = stats;
+		s.live = Size();
+		return s;
+	}
+
+private:
+	void Move(size_t from, size_t to);
+	void Resize(size_t n);
+
+	Stats stats;
+	size_t Push(float x, float y, float vx, float vy, float rot, float rotSpeed, float r, AsteroidShape s, int dmg, int hitPoints);
+};
@@ -0,0 +1,51 @@
+﻿#include "Broadphase.h"
+
+#include <cstring>
+
+const char* BroadphaseName(BroadphaseKind k) {
+	switch (k) {
+	case BroadphaseKind::GRID:  return "grid";
+	case BroadphaseKind::SAP:   return "sap";
+	case BroadphaseKind::TREE:  return "tree";
+	case BroadphaseKind::BRUTE: return "brute";
+	}
+	return "?";
+}
+
+bool ParseBroadphase(const char* name, BroadphaseKind& out) {
+	for (BroadphaseKind k : { BroadphaseKind::GRID, BroadphaseKind::SAP, BroadphaseKind::TREE, BroadphaseKind::BRUTE }) {
+		if (strcmp(name, BroadphaseName(k)) == 0) {
+			out = k;
+			return true;
+		}
+	}
+	return false;
+}
+
+void Broadphase::Build(const AsteroidStore& a) {
+	count = a.Size();
+	switch (kind) {
+	case BroadphaseKind::GRID:
+		grid.Build(a.posX.data(), a.posY.data(), a.radius.data(), count);
+		break;
+	case BroadphaseKind::SAP:
+		sap.Build(a.posX.data(), a.posY.data(), a.radius.data(), count);
+		break;
+	case BroadphaseKind::TREE:
+		// Proxy i odpowiada indeksowi i. Po SwapRemove pod indeksem może być inna asteroida -
+		// wtedy pudełko wyskakuje poza tłuste i liść jest wstawiany od nowa, reszta zostaje.
+		while (treeProxies.size() > count) {
+			tree.DestroyProxy(treeProxies.back());
+			treeProxies.pop_back();
+		}
+		for (size_t i = 0; i < treeProxies.size(); ++i) {
+			tree.MoveProxy(treeProxies[i], Aabb::FromCircle({ a.posX[i], a.posY[i] }, a.radius[i]));
+		}
+		for (size_t i = treeProxies.size(); i < count; ++i) {
+			treeProxies.push_back(tree.CreateProxy(Aabb::FromCircle({ a.posX[i], a.posY[i] }, a.radius[i]), static_cast<int>(i)));
+		}
+		break;
+	case BroadphaseKind::BRUTE:
+		break;
+	}
+}
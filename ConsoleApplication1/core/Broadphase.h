@@ -0,0 +1,101 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+#include <raylib.h>
+
+#include "AabbTree.h"
+#include "AsteroidStore.h"
+#include "SpatialGrid.h"
+#include "SweepAndPrune.h"
+
+// --- BROADPHASE ---
+// Wybór broadphase dla asteroid w czasie działania. Wszystkie warianty zwracają kandydatów
+// posortowanych rosnąco, więc wynik kolizji (i StateHash) nie zależy od wyboru.
+enum class BroadphaseKind : uint8_t { GRID, SAP, TREE, BRUTE };
+
+const char* BroadphaseName(BroadphaseKind k);
+// "grid", "sap", "tree" albo "brute"; false dla nieznanej nazwy
+bool ParseBroadphase(const char* name, BroadphaseKind& out);
+
+class Broadphase {
+public:
+	void Reset(int worldW, int worldH, float cell) {
+		grid.Reset(worldW, worldH, cell);
+	}
+
+	// Pojemność wszystkich wariantów na objects okręgów o promieniu do maxRadius (po Reset)
+	void Reserve(size_t objects, float maxRadius) {
+		grid.Reserve(objects, maxRadius);
+		sap.Reserve(objects);
+		tree.Reserve(objects);
+		treeProxies.reserve(objects);
+	}
+
+	void SetKind(BroadphaseKind k) {
+		kind = k;
+	}
+
+	BroadphaseKind Kind() const {
+		return kind;
+	}
+
+	void Build(const AsteroidStore& a);
+
+	void Insert(int id, Vector2 pos, float radius) {
+		switch (kind) {
+		case BroadphaseKind::GRID:  grid.Insert(id, pos, radius); break;
+		case BroadphaseKind::SAP:   sap.Insert(id, pos, radius); break;
+		case BroadphaseKind::TREE:  treeProxies.push_back(tree.CreateProxy(Aabb::FromCircle(pos, radius), id)); break;
+		case BroadphaseKind::BRUTE: break;
+		}
+		count++;
+	}
+
+	void Query(Vector2 pos, float radius, std::vector<int>& out) const {
+		switch (kind) {
+		case BroadphaseKind::GRID:
+			grid.Query(pos, radius, out);
+			break;
+		case BroadphaseKind::SAP:
+			sap.Query(pos, radius, out);
+			break;
+		case BroadphaseKind::TREE:
+			tree.QueryCircle(pos, radius, out);
+			break;
+		case BroadphaseKind::BRUTE:
+			out.clear();
+			for (size_t i = 0; i < count; ++i) out.push_back(static_cast<int>(i));
+			break;
+		}
+	}
+
+	// Kandydaci dla okręgu o promieniu radius przesuwanego od p0 do p1 (CCD). Drzewo testuje
+	// sam odcinek; pozostałe pytają o okrąg opisany na całym odcinku.
+	void QuerySweep(Vector2 p0, Vector2 p1, float radius, std::vector<int>& out) const {
+		if (kind == BroadphaseKind::TREE) {
+			tree.QueryRay(p0, p1, radius, out);
+			return;
+		}
+		Vector2 mid = { (p0.x + p1.x) * 0.5f, (p0.y + p1.y) * 0.5f };
+		float half = 0.5f * sqrtf((p1.x - p0.x) * (p1.x - p0.x) + (p1.y - p0.y) * (p1.y - p0.y));
+		Query(mid, half + radius, out);
+	}
+
+	const SweepAndPrune& Sap() const {
+		return sap;
+	}
+
+	const AabbTree& Tree() const {
+		return tree;
+	}
+
+private:
+	BroadphaseKind kind = BroadphaseKind::GRID;
+	SpatialGrid grid;
+	SweepAndPrune sap;
+	AabbTree tree;
+	std::vector<int> treeProxies; // proxy drzewa dla indeksu asteroidy
+	size_t count = 0; // liczba obiektów (brute force)
+};
@@ -0,0 +1,90 @@
+﻿#include "Collision.h"
+#include "SimdKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	bool EarlierHit(const HitEvent& a, const HitEvent& b) {
+		if (a.toi != b.toi) return a.toi < b.toi;
+		if (a.projectile != b.projectile) return a.projectile < b.projectile;
+		return a.asteroid < b.asteroid;
+	}
+}
+
+void CollisionQuery::Reserve(size_t asteroids, size_t /*projectiles*/) {
+	projectileHits.reserve(asteroids);
+	candidates.reserve(asteroids);
+	candX.reserve(asteroids); candY.reserve(asteroids); candR.reserve(asteroids);
+	candVX.reserve(asteroids); candVY.reserve(asteroids);
+	candidateHit.reserve(asteroids);
+	candidateToi.reserve(asteroids);
+}
+
+void CollisionQuery::Gather(const AsteroidStore& asteroids, const std::vector<char>& asteroidDead) {
+	size_t n = 0;
+	candX.clear(); candY.clear(); candR.clear(); candVX.clear(); candVY.clear();
+	for (int ai : candidates) {
+		if (asteroidDead[ai]) continue;
+		candidates[n++] = ai;
+		candX.push_back(asteroids.posX[ai]);
+		candY.push_back(asteroids.posY[ai]);
+		candR.push_back(asteroids.radius[ai]);
+		candVX.push_back(asteroids.velX[ai]);
+		candVY.push_back(asteroids.velY[ai]);
+	}
+	candidates.resize(n);
+}
+
+void CollisionQuery::ProjectileHits(const ProjectilePool& projectiles, const AsteroidStore& asteroids, const Broadphase& broadphase,
+	const std::vector<char>& asteroidDead, float dt, std::vector<HitEvent>& out) {
+	out.clear();
+
+	// Zapytanie broadphase obejmuje odcinek pocisku powiększony o drogę najszybszej asteroidy
+	float asteroidReach = 0.f;
+	for (size_t i = 0; i < asteroids.Size(); ++i) {
+		asteroidReach = std::max(asteroidReach, asteroids.velX[i] * asteroids.velX[i] + asteroids.velY[i] * asteroids.velY[i]);
+	}
+	asteroidReach = sqrtf(asteroidReach) * dt;
+
+	for (size_t pi = 0; pi < projectiles.size(); ++pi) {
+		const Vector2 end = projectiles.Position(pi);
+		const Vector2 move = { projectiles.velX[pi] * dt, projectiles.velY[pi] * dt };
+		const Vector2 start = { end.x - move.x, end.y - move.y };
+		const float radius = projectiles.Radius(pi);
+
+		broadphase.QuerySweep(start, end, radius + asteroidReach, candidates);
+		Gather(asteroids, asteroidDead);
+		const size_t n = candidates.size();
+		candidateToi.resize(n);
+		if (SweptCircleToi(start.x, start.y, move.x, move.y, radius, candX.data(), candY.data(), candR.data(),
+			candVX.data(), candVY.data(), dt, n, candidateToi.data()) == 0) continue;
+		projectileHits.clear();
+		for (size_t c = 0; c < n; ++c) {
+			if (candidateToi[c] <= 1.f) {
+				projectileHits.push_back({ candidateToi[c], static_cast<uint32_t>(pi), candidates[c] });
+			}
+		}
+		if (projectileHits.size() > C_MAX_HITS_PER_PROJECTILE) {
+			std::partial_sort(projectileHits.begin(), projectileHits.begin() + C_MAX_HITS_PER_PROJECTILE, projectileHits.end(), EarlierHit);
+			droppedHits += projectileHits.size() - C_MAX_HITS_PER_PROJECTILE;
+			projectileHits.resize(C_MAX_HITS_PER_PROJECTILE);
+		}
+		out.insert(out.end(), projectileHits.begin(), projectileHits.end());
+	}
+
+	std::sort(out.begin(), out.end(), EarlierHit);
+}
+
+void CollisionQuery::CircleHits(Vector2 pos, float radius, const AsteroidStore& asteroids, const Broadphase& broadphase,
+	const std::vector<char>& asteroidDead, std::vector<int>& out) {
+	out.clear();
+	broadphase.Query(pos, radius, candidates);
+	Gather(asteroids, asteroidDead);
+	const size_t n = candidates.size();
+	candidateHit.resize(n);
+	if (CircleOverlapMask(pos.x, pos.y, radius, candX.data(), candY.data(), candR.data(), n, candidateHit.data()) == 0) return;
+	for (size_t c = 0; c < n; ++c) {
+		if (candidateHit[c]) out.push_back(candidates[c]);
+	}
+}
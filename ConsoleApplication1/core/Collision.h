@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <raylib.h>
+
+#include "AsteroidStore.h"
+#include "Broadphase.h"
+#include "ProjectilePool.h"
+
+// --- COLLISION QUERIES ---
+// Wykrywanie trafień bez zasad gry: broadphase, zebranie żywych kandydatów do SoA i kernele
+// (CircleOverlapMask, SweptCircleToi). Co z trafieniem zrobić, decyduje Game.
+// Bufory są wielokrotnego użytku, więc po Reserve zapytania nie alokują.
+
+struct HitEvent {
+	float toi;           // moment zderzenia w ticku, [0, 1]
+	uint32_t projectile;
+	int asteroid;
+};
+
+class CollisionQuery {
+public:
+	// Najwcześniejsze trafienia jednego pocisku w jednym ticku, które przechodzą do rozstrzygania.
+	// Limit daje stałą górną granicę bufora zdarzeń (brak alokacji w grze), ale zmienia rozgrywkę:
+	// pocisk przebijający (SPECIAL), który w jednym ticku zahacza o więcej asteroid, trafia
+	// nadmiarowe dopiero w następnym ticku - o ile wciąż na nie nachodzi; te już minięte przepadają.
+	// Zwykły pocisk zatrzymuje się na pierwszym trafieniu, więc jego limit nie dotyczy.
+	// Przycięcia liczy DroppedHits (headless i benchmark scenariuszy je wypisują).
+	static constexpr size_t C_MAX_HITS_PER_PROJECTILE = 8;
+
+	void Reserve(size_t asteroids, size_t projectiles);
+
+	// Trafienia pocisków w asteroidy w tym ticku (CCD), posortowane po TOI, potem po indeksach.
+	// Pociski są już po ruchu (odcinek pos - vel * dt -> pos), asteroidy jeszcze przed nim.
+	// Najwyżej C_MAX_HITS_PER_PROJECTILE na pocisk, więc out potrzebuje projectiles * tyle miejsca.
+	void ProjectileHits(const ProjectilePool& projectiles, const AsteroidStore& asteroids, const Broadphase& broadphase,
+		const std::vector<char>& asteroidDead, float dt, std::vector<HitEvent>& out);
+
+	// Trafienia odcięte przez C_MAX_HITS_PER_PROJECTILE od utworzenia (suma po wszystkich tickach)
+	uint64_t DroppedHits() const {
+		return droppedHits;
+	}
+
+	// Żywe asteroidy nachodzące na okrąg, rosnąco po indeksie
+	void CircleHits(Vector2 pos, float radius, const AsteroidStore& asteroids, const Broadphase& broadphase,
+		const std::vector<char>& asteroidDead, std::vector<int>& out);
+
+private:
+	// Zawęża candidates do żywych asteroid i kopiuje ich dane do cand*
+	void Gather(const AsteroidStore& asteroids, const std::vector<char>& asteroidDead);
+
+	std::vector<int> candidates;
+	std::vector<float> candX, candY, candR, candVX, candVY;
+	std::vector<char> candidateHit;
+	std::vector<float> candidateToi;
+	std::vector<HitEvent> projectileHits; // trafienia bieżącego pocisku przed przycięciem do limitu
+	uint64_t droppedHits = 0;
+};
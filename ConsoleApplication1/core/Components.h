@@ -0,0 +1,22 @@
+﻿#pragma once
+#include <cstdint>
+
+#include <raylib.h>
+
+// --- TRANSFORM, PHYSICS, FLAGS ---
+struct TransformA {
+	Vector2 position{};
+	float rotation{};
+};
+
+struct Physics {
+	Vector2 velocity{};
+	float rotationSpeed{};
+};
+
+// Cechy encji sprawdzane przy rozstrzyganiu trafień zamiast typu obiektu czy wartości pól
+enum EntityFlag : uint8_t {
+	FLAG_NONE = 0,
+	FLAG_PIERCING = 1 << 0, // pocisk przelatuje przez asteroidy
+	FLAG_BOSS = 1 << 1,     // zniszczenie bez apteczki i pocisku specjalnego kończy grę
+};
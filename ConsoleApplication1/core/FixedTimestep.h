@@ -0,0 +1,40 @@
+﻿#pragma once
+
+// --- FIXED TIMESTEP ---
+// Akumulator czasu dla symulacji o stałym kroku, niezależnej od liczby klatek okna.
+// Advance() mówi ile ticków wykonać w tej klatce; po przycięciu (maxSteps) nadmiar czasu
+// jest odrzucany, żeby po zacięciu symulacja nie goniła czasu coraz większą liczbą ticków.
+class FixedTimestep {
+public:
+	FixedTimestep(float tickRate, int maxStepsPerFrame)
+		: dt(1.f / tickRate), maxSteps(maxStepsPerFrame) {}
+
+	int Advance(float frameTime) {
+		accumulator += frameTime;
+		int steps = static_cast<int>(accumulator / dt);
+		if (steps > maxSteps) {
+			droppedTicks += steps - maxSteps;
+			steps = maxSteps;
+			accumulator = 0.f;
+		}
+		else {
+			accumulator -= steps * dt;
+		}
+		return steps;
+	}
+
+	float Dt() const {
+		return dt;
+	}
+
+	// Ile ticków odrzucono przez limit nadganiania
+	long long DroppedTicks() const {
+		return droppedTicks;
+	}
+
+private:
+	float dt;
+	int maxSteps;
+	float accumulator = 0.f;
+	long long droppedTicks = 0;
+};
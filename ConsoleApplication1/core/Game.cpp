@@ -0,0 +1,263 @@
+﻿#include "Game.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+#include <raymath.h>
+
+namespace {
+	// Rozstrzygnięcie trafienia pocisku w asteroidę, indeks: [asteroida przeżyła][pocisk przebija]
+	struct HitRule {
+		bool consumeProjectile; // pocisk wraca do puli
+		bool stopProjectile;    // koniec sprawdzania kolejnych asteroid dla tego pocisku w tym ticku
+	};
+
+	constexpr HitRule C_HIT_RULES[2][2] = {
+		// asteroida zniszczona
+		{ { true, true }, { false, false } },
+		// asteroida przeżyła (np. BigAsteroid)
+		{ { true, true }, { false, true } },
+	};
+
+	// Wektor jednostkowy kierunku strzału (oś Y ekranu rośnie w dół)
+	Vector2 ShootDirVector(ShootDir d) {
+		switch (d) {
+		case ShootDir::RIGHT: return { 1, 0 };
+		case ShootDir::DOWN:  return { 0, 1 };
+		case ShootDir::LEFT:  return { -1, 0 };
+		case ShootDir::UP:
+		default:              return { 0, -1 };
+		}
+	}
+}
+
+void Game::Step(const InputState& in, float dt) {
+	spawnTimer += dt;
+	if (gameEnded) {
+		return;
+	}
+
+	PROFILE_SCOPE(phase, ProfilePhase::INPUT_PLAYER);
+
+	// Update player
+	player->Update(dt, in);
+
+	// Restart logic
+	if (!player->IsAlive() && in.restart) {
+		Restart();
+	}
+	// Asteroid shape switch
+	if (in.shapeTriangle) {
+		currentShape = AsteroidShape::TRIANGLE;
+	}
+	if (in.shapeSquare) {
+		currentShape = AsteroidShape::SQUARE;
+	}
+	if (in.shapePentagon) {
+		currentShape = AsteroidShape::PENTAGON;
+	}
+	if (in.shapeRandom) {
+		currentShape = AsteroidShape::RANDOM;
+	}
+	if (in.nextShootDir) {
+		shootDir = static_cast<ShootDir>((static_cast<int>(shootDir) + 1) % 4);
+	}
+
+	// Weapon switch
+	if (in.nextWeapon) {
+		int next = (static_cast<int>(currentWeapon) + 1) % static_cast<int>(WeaponType::COUNT);
+		if (next == static_cast<int>(WeaponType::SPECIAL)) next = 0; // pomiń SPECIAL
+		currentWeapon = static_cast<WeaponType>(next);
+	}
+
+	// Shooting
+	PROFILE_SWITCH(phase, ProfilePhase::SHOOTING);
+	{
+		const WeaponStats& weapon = GetWeaponStats(currentWeapon);
+		if (player->IsAlive() && in.fire) {
+			shotTimer += dt;
+			float interval = 1.f / (weapon.fireRate * config.fireRateScale);
+
+			while (shotTimer >= interval) {
+				Vector2 p = player->GetPosition();
+				p.y -= player->GetRadius();
+
+				projectiles.EmitVolley(volleys[static_cast<int>(currentWeapon)], p, ShootDirVector(shootDir), weapon.speed,
+					weapon.damage, currentWeapon);
+
+				shotTimer -= interval;
+			}
+		}
+		if (player->IsAlive() && healthpacks > 0 && in.useHealthpack) {
+			usedHealthpack = true;
+			// Odzyskaj 20 HP, ale nie przekraczaj 100
+			int newHP = player->GetHP() + 20;
+			if (newHP > 100) newHP = 100;
+			// Ustaw nowe HP (potrzebna metoda SetHP)
+			player->SetHP(newHP);
+			healthpacks--;
+		}
+		// Wystrzał specjalnego pocisku
+		if (player->IsAlive() && specialReady && in.restart) {
+			usedSpecial = true;
+			Vector2 p = player->GetPosition();
+			p.y -= player->GetRadius();
+			const WeaponStats& special = GetWeaponStats(WeaponType::SPECIAL);
+			Vector2 velocity = Vector2Scale(ShootDirVector(shootDir), special.speed);
+			projectiles.Acquire(Projectile(p, velocity, special.damage, WeaponType::SPECIAL));
+			specialReady = false;
+			specialCharge = 0;
+		}
+
+		else {
+			float maxInterval = 1.f / (weapon.fireRate * config.fireRateScale);
+
+			if (shotTimer > maxInterval) {
+				shotTimer = fmodf(shotTimer, maxInterval);
+			}
+		}
+	}
+
+	// Spawn asteroids
+	PROFILE_SWITCH(phase, ProfilePhase::SPAWNING);
+	if (spawnTimer >= spawnInterval && asteroids.Size() < config.maxAsteroids) {
+		// Co najwyżej jeden spawn na tick, więc gęstsze fale idą paczkami
+		for (int i = 0; i < config.spawnBatch && asteroids.Size() < config.maxAsteroids; ++i) {
+			asteroids.Spawn(currentShape, C_WIDTH, C_HEIGHT, random.spawn);
+		}
+		spawnTimer = 0.f;
+		spawnInterval = random.spawn.Float(config.spawnMin, config.spawnMax);
+	}
+
+	// Update projectiles - move them forward and mark the ones that left the screen.
+	// Usuwane są dopiero po kolizjach, bo na odcinku przed wylotem też mogły coś trafić.
+	PROFILE_SWITCH(phase, ProfilePhase::PROJECTILE_UPDATE);
+	projectiles.Integrate(dt, C_WIDTH, C_HEIGHT, projectileDead);
+
+	// Projectile-Asteroid collisions (broadphase: siatka, sweep-and-prune, drzewo albo brute force)
+	PROFILE_SWITCH(phase, ProfilePhase::PROJECTILE_COLLISIONS);
+	broadphase.Build(asteroids);
+	// Zniszczone asteroidy usuwamy dopiero po obu przebiegach, żeby indeksy w broadphase były ważne
+	asteroidDead.assign(asteroids.Size(), 0);
+
+	// CCD w ruchu względnym: pocisk przeleciał w tym ticku odcinek (pos - vel * dt) -> pos, a asteroida
+	// w tym samym czasie przesuwa się z pozycji z początku ticku o vel * dt (Integrate asteroid
+	// zapisze ten ruch dopiero po kolizjach). SweptCircleToi szuka pierwszego zetknięcia obu
+	// poruszających się okręgów, więc nic nie przeskakuje się nawzajem. Trafienia przychodzą w kolejności
+	// czasu zderzenia (remisy: indeks pocisku, potem asteroidy), więc asteroidę dostaje pocisk,
+	// który doleciał pierwszy, a przebijający trafia kolejne asteroidy po kolei.
+	collision.ProjectileHits(projectiles, asteroids, broadphase, asteroidDead, dt, hitEvents);
+	projectileStopped.assign(projectiles.size(), 0);
+
+	for (const HitEvent& e : hitEvents) {
+		const uint32_t pi = e.projectile;
+		const int ai = e.asteroid;
+		if (projectileStopped[pi] || asteroidDead[ai]) continue;
+		const bool piercing = (projectiles.Flags(pi) & FLAG_PIERCING) != 0;
+
+		// Zwykła asteroida ma 1 hp, więc ginie od każdego trafienia
+		asteroids.hp[ai] -= projectiles.damage[pi];
+		const bool survived = asteroids.hp[ai] > 0;
+		const HitRule rule = C_HIT_RULES[survived][piercing];
+
+		if (!survived) {
+			if ((asteroids.flags[ai] & FLAG_BOSS) && !usedHealthpack && !usedSpecial && !config.endless) {
+				gameEnded = true;
+			}
+			asteroidDead[ai] = 1;
+			OnAsteroidDestroyed();
+		}
+		if (rule.consumeProjectile) {
+			projectileDead[pi] = 1;
+		}
+		if (rule.stopProjectile) {
+			projectileStopped[pi] = 1;
+		}
+	}
+
+	// Trafione i te poza ekranem wracają do puli jednym przebiegiem
+	projectiles.SwapRemove(projectileDead);
+
+	// Asteroid-Ship collisions (ten sam broadphase)
+	PROFILE_SWITCH(phase, ProfilePhase::SHIP_COLLISIONS);
+	if (player->IsAlive()) {
+		collision.CircleHits(player->GetPosition(), player->GetRadius(), asteroids, broadphase, asteroidDead, shipHits);
+		for (int ai : shipHits) {
+			if (!config.invulnerable) player->TakeDamage(asteroids.damage[ai]);
+			asteroidDead[ai] = 1; // Mark asteroid for removal due to collision
+			if (!player->IsAlive()) break;
+		}
+	}
+
+	// Move asteroids, then remove destroyed and off-screen ones (raz na tick)
+	asteroids.Integrate(dt, C_WIDTH, C_HEIGHT, asteroidDead);
+	asteroids.SwapRemove(asteroidDead);
+}
+
+void Game::OnAsteroidDestroyed() {
+	destroyedObstacles++;
+	if (destroyedObstacles >= 15) {
+		healthpacks++;
+		destroyedObstacles = 0;
+	}
+	if (!specialReady) {
+		specialCharge++;
+		if (specialCharge >= 10) {
+			specialReady = true;
+			specialCharge = 10;
+		}
+	}
+	destroyedAsteroids++;
+	if (destroyedAsteroids >= 30 && !bigAsteroidSpawned) {
+		size_t bi = asteroids.SpawnBig(C_WIDTH, C_HEIGHT, random.spawn);
+		if (bi != AsteroidStore::npos) { // pełny magazyn - spróbuje przy kolejnym zestrzeleniu
+			asteroidDead.push_back(0);
+			broadphase.Insert(static_cast<int>(bi), { asteroids.posX[bi], asteroids.posY[bi] }, asteroids.radius[bi]);
+			bigAsteroidSpawned = true;
+		}
+	}
+}
+
+namespace {
+	struct Fnv1a {
+		uint64_t h = 1469598103934665603ULL;
+
+		void Bytes(const void* data, size_t n) {
+			const unsigned char* p = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < n; ++i) {
+				h ^= p[i];
+				h *= 1099511628211ULL;
+			}
+		}
+
+		template <typename T>
+		void Value(const T& v) {
+			Bytes(&v, sizeof(T));
+		}
+
+		template <typename T>
+		void Array(const std::vector<T>& v) {
+			if (!v.empty()) Bytes(v.data(), v.size() * sizeof(T));
+		}
+	};
+}
+
+uint64_t Game::StateHash() const {
+	Fnv1a f;
+	f.Array(asteroids.posX); f.Array(asteroids.posY);
+	f.Array(asteroids.velX); f.Array(asteroids.velY);
+	f.Array(asteroids.hp);
+	for (size_t i = 0; i < projectiles.size(); ++i) {
+		f.Value(projectiles.posX[i]);
+		f.Value(projectiles.posY[i]);
+	}
+	f.Value(player->GetPosition().x);
+	f.Value(player->GetPosition().y);
+	f.Value(player->GetHP());
+	f.Value(destroyedAsteroids);
+	f.Value(healthpacks);
+	f.Value(specialCharge);
+	return f.h;
+}
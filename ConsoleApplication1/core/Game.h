@@ -0,0 +1,161 @@
+﻿#pragma once
+#include <array>
+#include <vector>
+#include <memory>
+
+#include "AsteroidStore.h"
+#include "Input.h"
+#include "Projectile.h"
+#include "ProjectilePool.h"
+#include "Ship.h"
+#include "Broadphase.h"
+#include "Collision.h"
+#include "Random.h"
+
+// --- GAME ---
+enum class ShootDir { UP, RIGHT, DOWN, LEFT };
+
+// Cała logika rozgrywki bez okna i rysowania: Step() dostaje wejście i dt,
+// a front-end raylib (main.cpp) albo runner headless decydują skąd one pochodzą.
+class Game {
+public:
+	static constexpr int C_WIDTH = 1200;
+	static constexpr int C_HEIGHT = 800;
+	static constexpr size_t MAX_AST = 150;
+	static constexpr float C_SPAWN_MIN = 0.5f;
+	static constexpr float C_SPAWN_MAX = 3.0f;
+
+	static constexpr int C_MAX_ASTEROIDS = 1000;
+	static constexpr int C_MAX_PROJECTILES = 10'000;
+	static constexpr float C_GRID_CELL = 64.f; // ~ średnica średniej asteroidy
+	static constexpr float C_SHIP_RADIUS = 900.f * 0.25f * 0.5f; // spaceship1.png w skali 0.25
+
+	// Symulacja idzie stałym krokiem niezależnie od klatek okna
+	static constexpr float C_TICK_RATE = 120.f;
+	static constexpr float C_TICK_DT = 1.f / C_TICK_RATE;
+	static constexpr int C_MAX_CATCHUP_STEPS = 8; // max ticków na jedną klatkę
+
+	// Parametry rozgrywki ustalane przy tworzeniu gry (scenariusze benchmarków, testy obciążenia).
+	// Domyślne wartości to zwykła gra.
+	struct Config {
+		float shipRadius = C_SHIP_RADIUS;
+		size_t maxAsteroids = MAX_AST;  // limit spawnu; powyżej C_MAX_ASTEROIDS magazyn rośnie przy tworzeniu gry
+		float spawnMin = C_SPAWN_MIN;   // przedział losowania odstępu między spawnami, s
+		float spawnMax = C_SPAWN_MAX;
+		int spawnBatch = 1;             // asteroid na jeden spawn
+		float fireRateScale = 1.f;      // mnożnik tempa ognia broni (fireRate z C_WEAPONS)
+		WeaponType weapon = WeaponType::LASER;
+		ShootDir shootDir = ShootDir::UP;
+		bool invulnerable = false;      // kolizje ze statkiem liczone, ale bez obrażeń
+		bool endless = false;           // zestrzelenie BigAsteroid nie kończy gry
+	};
+
+	// Ten sam seed i to samo wejście dają identyczny przebieg
+	explicit Game(uint64_t seed, float playerRadius = C_SHIP_RADIUS) : Game(seed, MakeConfig(playerRadius)) {}
+
+	Game(uint64_t seed, const Config& cfg) : config(cfg), random(seed), seed(seed),
+		player(std::make_unique<PlayerShip>(C_WIDTH, C_HEIGHT, cfg.shipRadius)),
+		currentWeapon(cfg.weapon), shootDir(cfg.shootDir) {
+		// Jedyna alokacja magazynu asteroid; BigAsteroid spawnuje się ponad limit
+		const size_t capacity = config.maxAsteroids + 1 > C_MAX_ASTEROIDS ? config.maxAsteroids + 1 : C_MAX_ASTEROIDS;
+		asteroids.Reserve(capacity);
+		broadphase.Reset(C_WIDTH, C_HEIGHT, C_GRID_CELL);
+		broadphase.Reserve(capacity, AsteroidStore::C_MAX_RADIUS);
+		collision.Reserve(capacity, C_MAX_PROJECTILES);
+		shipHits.reserve(capacity);
+		asteroidDead.reserve(capacity);
+		projectileDead.reserve(C_MAX_PROJECTILES);
+		projectileStopped.reserve(C_MAX_PROJECTILES);
+		hitEvents.reserve(C_MAX_PROJECTILES * CollisionQuery::C_MAX_HITS_PER_PROJECTILE);
+		for (int w = 0; w < static_cast<int>(WeaponType::COUNT); ++w) {
+			volleys[w] = MakeVolley(C_WEAPONS[w]);
+		}
+		Restart();
+	}
+
+	void Restart() {
+		player->Respawn(C_WIDTH, C_HEIGHT); // statek tworzony raz, restart bez alokacji
+		asteroids.Clear();
+		projectiles.Clear();
+		spawnTimer = 0.f;
+		spawnInterval = random.spawn.Float(config.spawnMin, config.spawnMax);
+	}
+
+	// Jeden tick symulacji; dt to krok stały (C_TICK_DT albo wybrany przez front-end)
+	void Step(const InputState& in, float dt);
+
+	const Ship& GetPlayer() const { return *player; }
+	const AsteroidStore& GetAsteroids() const { return asteroids; }
+	const ProjectilePool& GetProjectiles() const { return projectiles; }
+	WeaponType GetWeapon() const { return currentWeapon; }
+	ShootDir GetShootDir() const { return shootDir; }
+	bool IsEnded() const { return gameEnded; }
+	int GetDestroyedAsteroids() const { return destroyedAsteroids; }
+	bool IsBigAsteroidSpawned() const { return bigAsteroidSpawned; }
+	int GetHealthpacks() const { return healthpacks; }
+	int GetSpecialCharge() const { return specialCharge; }
+	bool IsSpecialReady() const { return specialReady; }
+	uint64_t GetSeed() const { return seed; }
+	const Config& GetConfig() const { return config; }
+	// Trafienia odcięte limitem CollisionQuery::C_MAX_HITS_PER_PROJECTILE (przesunięte na kolejny tick albo utracone)
+	uint64_t GetDroppedHits() const { return collision.DroppedHits(); }
+	// Zmiana obciążenia w trakcie gry (szukanie pojemności). Limit nie przekracza magazynu
+	// zarezerwowanego przy tworzeniu gry, a pociski ponad pulę są odrzucane, więc nie alokuje.
+	void SetLoad(size_t maxAsteroids, int spawnBatch, float fireRateScale) {
+		const size_t limit = asteroids.GetStats().capacity - 1; // miejsce na BigAsteroid
+		config.maxAsteroids = maxAsteroids < limit ? maxAsteroids : limit;
+		config.spawnBatch = spawnBatch;
+		config.fireRateScale = fireRateScale;
+	}
+	// Broadphase asteroid; wybór nie zmienia przebiegu symulacji, tylko jej koszt
+	void SetBroadphase(BroadphaseKind k) { broadphase.SetKind(k); }
+	BroadphaseKind GetBroadphase() const { return broadphase.Kind(); }
+
+	// Skrót stanu symulacji (FNV-1a) - porównanie nagrania z odtworzeniem
+	uint64_t StateHash() const;
+
+private:
+	static Config MakeConfig(float shipRadius) {
+		Config c;
+		c.shipRadius = shipRadius;
+		return c;
+	}
+
+	// Liczniki po zniszczeniu asteroidy: apteczki, ładowanie specjala, BigAsteroid po 30
+	void OnAsteroidDestroyed();
+
+	Config config;
+	RandomStreams random;
+	uint64_t seed;
+	std::unique_ptr<Ship> player;
+
+	float spawnTimer = 0.f;
+	float spawnInterval = 0.f;
+	WeaponType currentWeapon;
+	float shotTimer = 0.f;
+	ShootDir shootDir;
+
+	bool usedHealthpack = false;
+	bool usedSpecial = false;
+	bool gameEnded = false;
+	int destroyedAsteroids = 0;
+	bool bigAsteroidSpawned = false;
+	int healthpacks = 0;
+	int destroyedObstacles = 0;
+	int specialCharge = 0;
+	bool specialReady = false;
+
+	AsteroidStore asteroids;
+	ProjectilePool projectiles{ C_MAX_PROJECTILES };
+	std::array<VolleyPattern, static_cast<size_t>(WeaponType::COUNT)> volleys; // wzory salw z C_WEAPONS
+
+	Broadphase broadphase;
+	CollisionQuery collision;
+	std::vector<HitEvent> hitEvents;
+	std::vector<int> shipHits;
+	std::vector<char> asteroidDead;
+	std::vector<char> projectileDead;    // poza ekranem albo zużyte przy trafieniu
+	std::vector<char> projectileStopped; // nie sprawdzać dalszych trafień w tym ticku
+
+	AsteroidShape currentShape = AsteroidShape::TRIANGLE;
+};
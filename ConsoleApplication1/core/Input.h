@@ -0,0 +1,83 @@
+﻿#pragma once
+#include <cstdint>
+
+// --- INPUT ---
+// Stan klawiszy odczytany raz na klatkę. Symulacja nie pyta raylib bezpośrednio,
+// dzięki czemu tryb headless może podać własny skrypt wejścia.
+struct InputState {
+	bool moveUp = false;        // W
+	bool moveDown = false;      // S
+	bool moveLeft = false;      // A
+	bool moveRight = false;     // D
+	bool fire = false;          // SPACE (trzymany)
+	bool nextWeapon = false;    // TAB
+	bool nextShootDir = false;  // C
+	bool useHealthpack = false; // H
+	bool restart = false;       // R - restart po śmierci albo pocisk specjalny
+	bool shapeTriangle = false; // 1
+	bool shapeSquare = false;   // 2
+	bool shapePentagon = false; // 3
+	bool shapeRandom = false;   // 4
+};
+
+// Zapis stanu jednego ticku na 16 bitach (nagrywanie / odtwarzanie)
+inline uint16_t PackInput(const InputState& in) {
+	uint16_t bits = 0;
+	int b = 0;
+	for (bool key : { in.moveUp, in.moveDown, in.moveLeft, in.moveRight, in.fire, in.nextWeapon, in.nextShootDir,
+		in.useHealthpack, in.restart, in.shapeTriangle, in.shapeSquare, in.shapePentagon, in.shapeRandom }) {
+		if (key) bits |= static_cast<uint16_t>(1u << b);
+		++b;
+	}
+	return bits;
+}
+
+inline InputState UnpackInput(uint16_t bits) {
+	InputState in;
+	int b = 0;
+	for (bool* key : { &in.moveUp, &in.moveDown, &in.moveLeft, &in.moveRight, &in.fire, &in.nextWeapon, &in.nextShootDir,
+		&in.useHealthpack, &in.restart, &in.shapeTriangle, &in.shapeSquare, &in.shapePentagon, &in.shapeRandom }) {
+		*key = (bits >> b) & 1u;
+		++b;
+	}
+	return in;
+}
+
+// Zbiera wejście z klatek okna dla ticków symulacji o stałym kroku. Klawisze trzymane
+// biorą stan z ostatniej klatki, a wciśnięcia (TAB, C, H, R, 1-4) czekają na najbliższy
+// tick - nie giną, gdy klatka nie wykonała żadnego ticku, i nie powtarzają się, gdy wykonała kilka.
+class InputLatch {
+public:
+	void Accumulate(const InputState& frame) {
+		pending.moveUp = frame.moveUp;
+		pending.moveDown = frame.moveDown;
+		pending.moveLeft = frame.moveLeft;
+		pending.moveRight = frame.moveRight;
+		pending.fire = frame.fire;
+		pending.nextWeapon |= frame.nextWeapon;
+		pending.nextShootDir |= frame.nextShootDir;
+		pending.useHealthpack |= frame.useHealthpack;
+		pending.restart |= frame.restart;
+		pending.shapeTriangle |= frame.shapeTriangle;
+		pending.shapeSquare |= frame.shapeSquare;
+		pending.shapePentagon |= frame.shapePentagon;
+		pending.shapeRandom |= frame.shapeRandom;
+	}
+
+	// Wejście dla jednego ticku; wciśnięcia są kasowane po oddaniu
+	InputState Consume() {
+		InputState tick = pending;
+		pending.nextWeapon = false;
+		pending.nextShootDir = false;
+		pending.useHealthpack = false;
+		pending.restart = false;
+		pending.shapeTriangle = false;
+		pending.shapeSquare = false;
+		pending.shapePentagon = false;
+		pending.shapeRandom = false;
+		return tick;
+	}
+
+private:
+	InputState pending;
+};
@@ -0,0 +1,120 @@
+﻿#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS // fopen
+#endif
+#include "InputRecording.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+	constexpr char MAGIC[4] = { 'A', 'S', 'T', 'R' };
+	constexpr uint32_t VERSION = 1;
+	constexpr uint64_t RUN_BYTES = sizeof(uint16_t) * 2; // bits + count
+
+	template <typename T>
+	bool WriteValue(FILE* f, const T& v) {
+		return fwrite(&v, sizeof(T), 1, f) == 1;
+	}
+
+	template <typename T>
+	bool ReadValue(FILE* f, T& v) {
+		return fread(&v, sizeof(T), 1, f) == 1;
+	}
+}
+
+InputRecorder::InputRecorder(uint64_t seed, float tickRate, float shipRadius) {
+	header.seed = seed;
+	header.tickRate = tickRate;
+	header.shipRadius = shipRadius;
+	runs.reserve(4096);
+}
+
+void InputRecorder::Reserve(size_t ticks) {
+	runs.reserve(ticks);
+}
+
+void InputRecorder::Record(const InputState& in) {
+	uint16_t bits = PackInput(in);
+	if (!runs.empty() && runs.back().bits == bits && runs.back().count < UINT16_MAX) {
+		++runs.back().count;
+	}
+	else {
+		runs.push_back({ bits, 1 });
+	}
+	++header.ticks;
+}
+
+bool InputRecorder::Save(const char* path) const {
+	FILE* f = fopen(path, "wb");
+	if (!f) return false;
+
+	uint64_t runCount = runs.size();
+	bool ok = fwrite(MAGIC, sizeof(MAGIC), 1, f) == 1
+		&& WriteValue(f, VERSION)
+		&& WriteValue(f, header.seed)
+		&& WriteValue(f, header.tickRate)
+		&& WriteValue(f, header.shipRadius)
+		&& WriteValue(f, header.ticks)
+		&& WriteValue(f, runCount);
+	for (size_t i = 0; ok && i < runs.size(); ++i) {
+		ok = WriteValue(f, runs[i].bits) && WriteValue(f, runs[i].count);
+	}
+	return fclose(f) == 0 && ok;
+}
+
+bool InputReplay::Load(const char* path) {
+	FILE* f = fopen(path, "rb");
+	if (!f) return false;
+
+	char magic[4] = {};
+	uint32_t version = 0;
+	uint64_t runCount = 0;
+	bool ok = fread(magic, sizeof(magic), 1, f) == 1 && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0
+		&& ReadValue(f, version) && version == VERSION
+		&& ReadValue(f, header.seed)
+		&& ReadValue(f, header.tickRate)
+		&& ReadValue(f, header.shipRadius)
+		&& ReadValue(f, header.ticks)
+		&& ReadValue(f, runCount);
+	// Odtwarzacze dzielą przez tickRate, a promień trafia do Game bez sprawdzania
+	ok = ok && std::isfinite(header.tickRate) && header.tickRate > 0.f
+		&& std::isfinite(header.shipRadius) && header.shipRadius > 0.f;
+
+	// runCount z pliku nie może zarezerwować więcej, niż plik faktycznie zawiera
+	if (ok) {
+		const long dataStart = ftell(f);
+		ok = dataStart >= 0 && fseek(f, 0, SEEK_END) == 0;
+		const long fileEnd = ok ? ftell(f) : -1;
+		ok = ok && fileEnd >= dataStart && fseek(f, dataStart, SEEK_SET) == 0
+			&& runCount == static_cast<uint64_t>(fileEnd - dataStart) / RUN_BYTES
+			&& static_cast<uint64_t>(fileEnd - dataStart) % RUN_BYTES == 0;
+	}
+
+	runs.clear();
+	if (ok) runs.resize(static_cast<size_t>(runCount));
+	uint64_t ticks = 0;
+	for (size_t i = 0; ok && i < runs.size(); ++i) {
+		ok = ReadValue(f, runs[i].bits) && ReadValue(f, runs[i].count) && runs[i].count > 0;
+		ticks += ok ? runs[i].count : 0;
+	}
+	ok = ok && ticks == header.ticks;
+	fclose(f);
+
+	runIndex = 0;
+	usedInRun = 0;
+	if (!ok) runs.clear();
+	return ok;
+}
+
+bool InputReplay::Next(InputState& out) {
+	while (runIndex < runs.size() && usedInRun >= runs[runIndex].count) {
+		++runIndex;
+		usedInRun = 0;
+	}
+	if (runIndex >= runs.size()) return false;
+
+	out = UnpackInput(runs[runIndex].bits);
+	++usedInRun;
+	return true;
+}
@@ -0,0 +1,64 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Input.h"
+
+// --- INPUT RECORDING ---
+// Plik nagrania: nagłówek (seed, tick rate, promień statku, liczba ticków) i wejście
+// kolejnych ticków jako pary (stan 16-bitowy, długość serii). Trzymane klawisze powtarzają
+// się przez setki ticków, więc godzina gry to zwykle kilka-kilkanaście kB.
+// Z tym samym seedem i tym samym wejściem Game::Step odtwarza przebieg tick w tick.
+struct InputRecordingHeader {
+	uint64_t seed = 0;
+	float tickRate = 0.f;
+	float shipRadius = 0.f;
+	uint64_t ticks = 0;
+};
+
+class InputRecorder {
+public:
+	InputRecorder(uint64_t seed, float tickRate, float shipRadius);
+
+	// Najgorszy przypadek: każdy tick otwiera nową serię
+	void Reserve(size_t ticks);
+	void Record(const InputState& in);
+	bool Save(const char* path) const;
+
+	uint64_t Ticks() const {
+		return header.ticks;
+	}
+
+private:
+	struct Run {
+		uint16_t bits;
+		uint16_t count;
+	};
+
+	InputRecordingHeader header;
+	std::vector<Run> runs;
+};
+
+class InputReplay {
+public:
+	bool Load(const char* path);
+
+	const InputRecordingHeader& Header() const {
+		return header;
+	}
+
+	// false po ostatnim nagranym ticku
+	bool Next(InputState& out);
+
+private:
+	struct Run {
+		uint16_t bits;
+		uint16_t count;
+	};
+
+	InputRecordingHeader header;
+	std::vector<Run> runs;
+	size_t runIndex = 0;
+	uint16_t usedInRun = 0;
+};
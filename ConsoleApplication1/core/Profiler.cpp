@@ -0,0 +1,92 @@
+﻿#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS // fopen
+#endif
+#include "Profiler.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+
+const char* ProfilePhaseName(ProfilePhase phase) {
+	switch (phase) {
+	case ProfilePhase::INPUT_PLAYER:          return "input_player";
+	case ProfilePhase::SHOOTING:              return "shooting";
+	case ProfilePhase::SPAWNING:              return "spawning";
+	case ProfilePhase::PROJECTILE_UPDATE:     return "projectile_update";
+	case ProfilePhase::PROJECTILE_COLLISIONS: return "projectile_asteroid";
+	case ProfilePhase::SHIP_COLLISIONS:       return "asteroid_ship";
+	case ProfilePhase::HUD_TEXT:              return "hud_text";
+	case ProfilePhase::ENTITY_DRAW:           return "entity_draw";
+	default:                                  return "?";
+	}
+}
+
+void Profiler::Record(ProfilePhase phase, int64_t startNs, int64_t durationNs) {
+	if (enabled) Add(phase, durationNs);
+	if (trace) trace->Complete(ProfilePhaseName(phase), startNs, durationNs);
+}
+
+void Profiler::EndFrame() {
+	if (!enabled) return;
+
+	for (int p = 0; p < C_PHASES; ++p) {
+		history[p][historyHead] = current[p];
+	}
+	historyHead = (historyHead + 1) % C_HISTORY;
+	historyCount = std::min(historyCount + 1, C_HISTORY);
+
+	if (csv) {
+		fprintf(csv, "%llu", static_cast<unsigned long long>(frame));
+		for (int p = 0; p < C_PHASES; ++p) {
+			fprintf(csv, ",%.4f", current[p] * 1e-6);
+		}
+		fputc('\n', csv);
+	}
+
+	current.fill(0);
+	++frame;
+}
+
+double Profiler::AverageMs(ProfilePhase phase) const {
+	if (historyCount == 0) return 0.0;
+	const auto& h = history[static_cast<int>(phase)];
+	int64_t sum = 0;
+	for (int i = 0; i < historyCount; ++i) sum += h[i];
+	return sum * 1e-6 / historyCount;
+}
+
+double Profiler::P99Ms(ProfilePhase phase) const {
+	if (historyCount == 0) return 0.0;
+	std::array<int64_t, C_HISTORY> sorted;
+	const auto& h = history[static_cast<int>(phase)];
+	std::copy(h.begin(), h.begin() + historyCount, sorted.begin());
+	int k = std::min(historyCount - 1, historyCount * 99 / 100);
+	std::nth_element(sorted.begin(), sorted.begin() + k, sorted.begin() + historyCount);
+	return sorted[k] * 1e-6;
+}
+
+double Profiler::FrameAverageMs() const {
+	double sum = 0.0;
+	for (int p = 0; p < C_PHASES; ++p) sum += AverageMs(static_cast<ProfilePhase>(p));
+	return sum;
+}
+
+bool Profiler::OpenCsv(const char* path) {
+	CloseCsv();
+	csv = fopen(path, "w");
+	if (!csv) return false;
+
+	fputs("frame", csv);
+	for (int p = 0; p < C_PHASES; ++p) {
+		fprintf(csv, ",%s_ms", ProfilePhaseName(static_cast<ProfilePhase>(p)));
+	}
+	fputc('\n', csv);
+	enabled = true;
+	return true;
+}
+
+void Profiler::CloseCsv() {
+	if (csv) {
+		fclose(csv);
+		csv = nullptr;
+	}
+}
@@ -0,0 +1,136 @@
+﻿#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// --- PROFILER ---
+// Czas poszczególnych faz klatki. Wyłączony profiler kosztuje jedno sprawdzenie bool na fazę
+// (bez odczytu zegara); z ASTEROIDS_DISABLE_PROFILER zakresy znikają całkowicie.
+// Jeden profiler na wątek - każda instancja Game w osobnym wątku mierzy się osobno.
+// Podpięty TraceRecorder dostaje każdą fazę jako zdarzenie z czasem trwania.
+
+class TraceRecorder;
+
+enum class ProfilePhase : uint8_t {
+	INPUT_PLAYER,          // wejście, ruch gracza, przełączniki
+	SHOOTING,              // strzały, apteczka, pocisk specjalny
+	SPAWNING,              // spawn asteroid
+	PROJECTILE_UPDATE,     // ruch pocisków
+	PROJECTILE_COLLISIONS, // pocisk-asteroida (z budową broadphase)
+	SHIP_COLLISIONS,       // asteroida-statek, ruch i usuwanie asteroid
+	HUD_TEXT,              // napisy HUD (front-end)
+	ENTITY_DRAW,           // rysowanie encji (front-end)
+	COUNT
+};
+
+const char* ProfilePhaseName(ProfilePhase phase);
+
+class Profiler {
+public:
+	static constexpr int C_HISTORY = 240; // klatek w statystykach kroczących
+	static constexpr int C_PHASES = static_cast<int>(ProfilePhase::COUNT);
+
+	static Profiler& Instance() {
+		static thread_local Profiler inst;
+		return inst;
+	}
+
+	void SetEnabled(bool on) {
+		enabled = on;
+	}
+
+	bool IsEnabled() const {
+		return enabled;
+	}
+
+	// Zakresy mierzą czas, gdy działa profiler albo nagrywanie trace
+	bool IsCapturing() const {
+		return enabled || trace != nullptr;
+	}
+
+	void SetTrace(TraceRecorder* recorder) {
+		trace = recorder;
+	}
+
+	void Add(ProfilePhase phase, int64_t ns) {
+		current[static_cast<int>(phase)] += ns;
+	}
+
+	// Wynik jednego zakresu: suma fazy w klatce i zdarzenie trace
+	void Record(ProfilePhase phase, int64_t startNs, int64_t durationNs);
+
+	// Zamyka klatkę: sumy faz trafiają do historii i (opcjonalnie) do CSV
+	void EndFrame();
+
+	// Statystyki z ostatnich C_HISTORY klatek, w ms
+	double AverageMs(ProfilePhase phase) const;
+	double P99Ms(ProfilePhase phase) const;
+	double FrameAverageMs() const;
+
+	// Zapis czasu każdej klatki do CSV (frame,faza1_ms,...); włącza profiler
+	bool OpenCsv(const char* path);
+	void CloseCsv();
+
+	~Profiler() {
+		CloseCsv();
+	}
+
+private:
+	Profiler() = default;
+
+	bool enabled = false;
+	TraceRecorder* trace = nullptr;
+	std::array<int64_t, C_PHASES> current{};
+	std::array<std::array<int64_t, C_HISTORY>, C_PHASES> history{};
+	int historyCount = 0;
+	int historyHead = 0;
+	uint64_t frame = 0;
+	FILE* csv = nullptr;
+};
+
+// Mierzy czas od konstrukcji do końca zakresu. Switch() zamyka bieżącą fazę i zaczyna
+// następną - wygodne w długiej funkcji złożonej z kolejnych faz (Game::Step).
+class ProfileScope {
+public:
+	explicit ProfileScope(ProfilePhase p) : phase(p) {
+		active = Profiler::Instance().IsCapturing();
+		if (active) start = NowNs();
+	}
+
+	void Switch(ProfilePhase next) {
+		if (active) {
+			int64_t now = NowNs();
+			Profiler::Instance().Record(phase, start, now - start);
+			start = now;
+		}
+		phase = next;
+	}
+
+	~ProfileScope() {
+		if (active) {
+			Profiler::Instance().Record(phase, start, NowNs() - start);
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	static int64_t NowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	ProfilePhase phase;
+	bool active = false;
+	int64_t start = 0;
+};
+
+#ifdef ASTEROIDS_DISABLE_PROFILER
+#define PROFILE_SCOPE(name, phase) do {} while (0)
+#define PROFILE_SWITCH(name, phase) do {} while (0)
+#else
+#define PROFILE_SCOPE(name, phase) ProfileScope name(phase)
+#define PROFILE_SWITCH(name, phase) name.Switch(phase)
+#endif
@@ -0,0 +1,48 @@
+﻿#pragma once
+#include <raylib.h>
+#include <raymath.h>
+
+#include "Components.h"
+#include "Weapons.h"
+
+// --- PROJECTILE HIERARCHY ---
+class Projectile {
+public:
+	Projectile(Vector2 pos, Vector2 vel, int dmg, WeaponType wt)
+	{
+		transform.position = pos;
+		physics.velocity = vel;
+		baseDamage = dmg;
+		type = wt;
+	}
+	// Ruch i wylot poza ekran liczy ProjectilePool::Integrate dla wszystkich pocisków naraz
+	Vector2 GetPosition() const {
+		return transform.position;
+	}
+
+	Vector2 GetVelocity() const {
+		return physics.velocity;
+	}
+
+	float GetRadius() const {
+		return GetWeaponStats(type).radius;
+	}
+
+	int GetDamage() const {
+		return baseDamage;
+	}
+
+	WeaponType GetType() const {
+		return type;
+	}
+
+	uint8_t GetFlags() const {
+		return GetWeaponStats(type).flags;
+	}
+
+private:
+	TransformA transform;
+	Physics    physics;
+	int        baseDamage;
+	WeaponType type;
+};
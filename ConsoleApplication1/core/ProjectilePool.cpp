@@ -0,0 +1,98 @@
+﻿#include "ProjectilePool.h"
+#include "SimdKernels.h"
+
+ProjectilePool::ProjectilePool(size_t capacity) {
+	posX.reserve(capacity); posY.reserve(capacity);
+	velX.reserve(capacity); velY.reserve(capacity);
+	damage.reserve(capacity);
+	type.reserve(capacity);
+	stats.capacity = capacity;
+}
+
+void ProjectilePool::Push(float x, float y, float vx, float vy, int dmg, WeaponType wt) {
+	posX.push_back(x); posY.push_back(y);
+	velX.push_back(vx); velY.push_back(vy);
+	damage.push_back(dmg);
+	type.push_back(wt);
+}
+
+bool ProjectilePool::Acquire(const Projectile& p) {
+	if (size() == stats.capacity) {
+		stats.overflow++;
+		return false;
+	}
+	Vector2 pos = p.GetPosition();
+	Vector2 vel = p.GetVelocity();
+	Push(pos.x, pos.y, vel.x, vel.y, p.GetDamage(), p.GetType());
+	stats.acquired++;
+	if (size() > stats.highWater) stats.highWater = size();
+	return true;
+}
+
+size_t ProjectilePool::EmitVolley(const VolleyPattern& v, Vector2 origin, Vector2 dir, float speed, int dmg, WeaponType wt) {
+	size_t room = stats.capacity - size();
+	size_t n = static_cast<size_t>(v.count);
+	if (n > room) {
+		stats.overflow += n - room;
+		n = room;
+	}
+	for (size_t i = 0; i < n; ++i) {
+		Vector2 d = RotateToDir(v.dir[i], dir);
+		Vector2 o = RotateToDir(v.offset[i], dir);
+		float s = speed * v.speedScale[i];
+		Push(origin.x + o.x, origin.y + o.y, d.x * s, d.y * s, dmg, wt);
+	}
+	stats.acquired += n;
+	if (size() > stats.highWater) stats.highWater = size();
+	return n;
+}
+
+void ProjectilePool::Move(size_t from, size_t to) {
+	posX[to] = posX[from]; posY[to] = posY[from];
+	velX[to] = velX[from]; velY[to] = velY[from];
+	damage[to] = damage[from];
+	type[to] = type[from];
+}
+
+void ProjectilePool::Resize(size_t n) {
+	posX.resize(n); posY.resize(n);
+	velX.resize(n); velY.resize(n);
+	damage.resize(n);
+	type.resize(n);
+}
+
+void ProjectilePool::Release(size_t i) {
+	size_t last = size() - 1;
+	if (i != last) Move(last, i);
+	Resize(last);
+	stats.released++;
+}
+
+void ProjectilePool::SwapRemove(std::vector<char>& dead) {
+	size_t n = size();
+	for (size_t i = 0; i < n;) {
+		if (!dead[i]) {
+			++i;
+			continue;
+		}
+		// Ostatni element wskakuje na i i jest sprawdzany w kolejnym obrocie
+		--n;
+		if (i != n) {
+			Move(n, i);
+			dead[i] = dead[n];
+		}
+	}
+	stats.released += size() - n;
+	Resize(n);
+}
+
+void ProjectilePool::Clear() {
+	stats.released += size();
+	Resize(0);
+}
+
+void ProjectilePool::Integrate(float dt, int screenW, int screenH, std::vector<char>& dead) {
+	dead.assign(size(), 0);
+	IntegrateMarkOutOfBounds(posX.data(), posY.data(), velX.data(), velY.data(), nullptr, size(), dt,
+		static_cast<float>(screenW), static_cast<float>(screenH), dead.data());
+}
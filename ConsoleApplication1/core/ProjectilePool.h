@@ -0,0 +1,71 @@
+﻿#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Projectile.h"
+#include "Volley.h"
+
+// --- PROJECTILE POOL ---
+// Pociski o stałej pojemności w tablicach SoA: pamięć rezerwowana raz w konstruktorze, więc
+// strzelanie nigdy nie alokuje. Żywe pociski leżą ciągiem [0, size), a wolne miejsca to ogon
+// tablic: Acquire dokłada na koniec, Release przenosi ostatni pocisk na zwolnione miejsce (O(1)).
+// Game zwalnia pociski paczką po ticku (SwapRemove: ta sama zamiana z ostatnim dla każdego z dead).
+// Po zapełnieniu nowe pociski są odrzucane i liczone w overflow.
+// Tablice są publiczne do odczytu w pętlach kolizji i rysowania; zmiany tylko przez metody puli.
+class ProjectilePool {
+public:
+	struct Stats {
+		size_t capacity = 0;
+		size_t live = 0;
+		size_t highWater = 0;     // najwięcej żywych pocisków naraz
+		uint64_t acquired = 0;
+		uint64_t released = 0;
+		uint64_t overflow = 0;    // odrzucone, bo pula była pełna
+	};
+
+	std::vector<float> posX, posY;
+	std::vector<float> velX, velY;
+	std::vector<int> damage;
+	std::vector<WeaponType> type;
+
+	explicit ProjectilePool(size_t capacity);
+
+	bool Acquire(const Projectile& p);
+	// Cała salwa naraz: miejsce sprawdzane raz, kierunki wzoru obracane o dir (jednostkowy).
+	// Zwraca liczbę dodanych pocisków; nadmiar ponad pojemność trafia do overflow.
+	size_t EmitVolley(const VolleyPattern& v, Vector2 origin, Vector2 dir, float speed, int dmg, WeaponType wt);
+
+	// Zmienia kolejność: na miejsce i trafia ostatni pocisk
+	void Release(size_t i);
+	// Zwalnia pociski z dead[i] != 0 (swap-and-pop, dead przestawiane razem z danymi)
+	void SwapRemove(std::vector<char>& dead);
+	void Clear();
+
+	// Ruch wszystkich pocisków (kernel SIMD); dead[i] = 1 dla tych, które wyleciały poza ekran
+	void Integrate(float dt, int screenW, int screenH, std::vector<char>& dead);
+
+	size_t size() const { return posX.size(); }
+	bool empty() const { return posX.empty(); }
+
+	Vector2 Position(size_t i) const { return { posX[i], posY[i] }; }
+	float Radius(size_t i) const { return GetWeaponStats(type[i]).radius; }
+	uint8_t Flags(size_t i) const { return GetWeaponStats(type[i]).flags; }
+	// Kopia pocisku i (do rysowania)
+	Projectile operator[](size_t i) const {
+		return Projectile(Position(i), { velX[i], velY[i] }, damage[i], type[i]);
+	}
+
+	Stats GetStats() const {
+		Stats s = stats;
+		s.live = size();
+		return s;
+	}
+
+private:
+	void Push(float x, float y, float vx, float vy, int dmg, WeaponType wt);
+	void Move(size_t from, size_t to);
+	void Resize(size_t n);
+
+	Stats stats;
+};
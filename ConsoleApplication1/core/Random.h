@@ -0,0 +1,81 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// --- RANDOM ---
+// PCG32 (O'Neill, XSH-RR): 64 bity stanu, 32 bity wyniku. Ziarno + numer strumienia dają
+// niezależne ciągi, więc każdy podsystem (i każdy wątek / instancja headless) ma własny
+// generator bez globalnego stanu i bez blokad. Ten sam seed = identyczny przebieg gry.
+class Rng {
+public:
+	Rng() {
+		Seed(0x853c49e6748fea9bULL, 0);
+	}
+
+	Rng(uint64_t seed, uint64_t stream) {
+		Seed(seed, stream);
+	}
+
+	void Seed(uint64_t seed, uint64_t stream) {
+		state = 0;
+		inc = (stream << 1u) | 1u;
+		NextU32();
+		state += seed;
+		NextU32();
+	}
+
+	uint32_t NextU32() {
+		uint64_t old = state;
+		state = old * 6364136223846793005ULL + inc;
+		uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+		uint32_t rot = static_cast<uint32_t>(old >> 59u);
+		return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+	}
+
+	// [0, 1), 24 bity mantysy
+	float NextFloat() {
+		return static_cast<float>(NextU32() >> 8) * (1.f / 16777216.f);
+	}
+
+	float Float(float min, float max) {
+		return min + NextFloat() * (max - min);
+	}
+
+	// Oba końce włącznie (jak GetRandomValue z raylib)
+	int Int(int min, int max) {
+		uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+		return min + static_cast<int>((static_cast<uint64_t>(NextU32()) * range) >> 32);
+	}
+
+	// Wypełnianie hurtem - jedna pętla bez rozgałęzień, np. przy spawnie całej fali
+	void Fill(uint32_t* out, size_t n) {
+		for (size_t i = 0; i < n; ++i) out[i] = NextU32();
+	}
+
+	void Fill(float* out, size_t n, float min, float max) {
+		const float scale = (max - min) * (1.f / 16777216.f);
+		for (size_t i = 0; i < n; ++i) out[i] = min + static_cast<float>(NextU32() >> 8) * scale;
+	}
+
+private:
+	uint64_t state;
+	uint64_t inc;
+};
+
+// Osobne strumienie gry z jednego ziarna: losowanie w jednym podsystemie nie przesuwa
+// ciągu w innym (np. nowa broń z rozrzutem nie zmienia spawnu asteroid).
+struct RandomStreams {
+	Rng spawn;   // asteroidy, interwały spawnu
+	Rng weapons; // rozrzut / wzorce broni
+	Rng effects; // efekty wizualne, nie wpływają na symulację
+
+	explicit RandomStreams(uint64_t seed = 0) {
+		Seed(seed);
+	}
+
+	void Seed(uint64_t seed) {
+		spawn.Seed(seed, 1);
+		weapons.Seed(seed, 2);
+		effects.Seed(seed, 3);
+	}
+};
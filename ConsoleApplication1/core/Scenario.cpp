@@ -0,0 +1,142 @@
+﻿#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS // fopen
+#endif
+#include "Scenario.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+	std::string Trim(const std::string& s) {
+		size_t b = 0, e = s.size();
+		while (b < e && isspace(static_cast<unsigned char>(s[b]))) ++b;
+		while (e > b && isspace(static_cast<unsigned char>(s[e - 1]))) --e;
+		return s.substr(b, e - b);
+	}
+
+	std::string Lower(std::string s) {
+		for (char& c : s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+		return s;
+	}
+
+	bool ParseBool(const std::string& v, bool& out) {
+		if (v == "true" || v == "1" || v == "yes") { out = true; return true; }
+		if (v == "false" || v == "0" || v == "no") { out = false; return true; }
+		return false;
+	}
+
+	bool ParseFloat(const std::string& v, float& out) {
+		char* end = nullptr;
+		out = strtof(v.c_str(), &end);
+		return !v.empty() && *end == '\0';
+	}
+
+	bool ParseUnsigned(const std::string& v, unsigned long long& out) {
+		char* end = nullptr;
+		out = strtoull(v.c_str(), &end, 10);
+		return !v.empty() && v[0] != '-' && *end == '\0';
+	}
+
+	// SPECIAL nie jest bronią do wyboru (odpalany R)
+	bool ParseWeapon(const std::string& v, WeaponType& out) {
+		for (int w = 0; w < static_cast<int>(WeaponType::SPECIAL); ++w) {
+			if (v == Lower(C_WEAPONS[w].name)) {
+				out = static_cast<WeaponType>(w);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ParseShootDir(const std::string& v, ShootDir& out) {
+		const char* names[] = { "up", "right", "down", "left" };
+		for (int d = 0; d < 4; ++d) {
+			if (v == names[d]) {
+				out = static_cast<ShootDir>(d);
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+bool LoadScenario(const char* path, Scenario& out) {
+	FILE* f = fopen(path, "r");
+	if (!f) {
+		fprintf(stderr, "%s: cannot open scenario\n", path);
+		return false;
+	}
+
+	Scenario sc;
+	sc.name = path;
+	char buf[512];
+	int lineNo = 0;
+	bool ok = true;
+	while (ok && fgets(buf, sizeof(buf), f)) {
+		++lineNo;
+		std::string line = buf;
+		if (lineNo == 1 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) line.erase(0, 3); // BOM
+		size_t hash = line.find('#');
+		if (hash != std::string::npos) line.erase(hash);
+		line = Trim(line);
+		if (line.empty()) continue;
+
+		size_t eq = line.find('=');
+		if (eq == std::string::npos) {
+			fprintf(stderr, "%s:%d: expected 'key = value'\n", path, lineNo);
+			ok = false;
+			break;
+		}
+		const std::string key = Lower(Trim(line.substr(0, eq)));
+		const std::string raw = Trim(line.substr(eq + 1));
+		const std::string value = Lower(raw);
+		unsigned long long u = 0;
+
+		bool valid = true;
+		if (key == "name") sc.name = raw;
+		else if (key == "seed") {
+			valid = ParseUnsigned(value, u);
+			sc.seed = u;
+		}
+		else if (key == "ticks") {
+			valid = ParseUnsigned(value, u) && u > 0;
+			sc.ticks = static_cast<long long>(u);
+		}
+		else if (key == "spawn_min") valid = ParseFloat(value, sc.game.spawnMin) && sc.game.spawnMin > 0.f;
+		else if (key == "spawn_max") valid = ParseFloat(value, sc.game.spawnMax) && sc.game.spawnMax > 0.f;
+		else if (key == "spawn_batch") {
+			valid = ParseUnsigned(value, u) && u > 0 && u <= 1000;
+			sc.game.spawnBatch = static_cast<int>(u);
+		}
+		else if (key == "max_ast") {
+			valid = ParseUnsigned(value, u);
+			sc.game.maxAsteroids = static_cast<size_t>(u);
+		}
+		else if (key == "weapon") valid = ParseWeapon(value, sc.game.weapon);
+		else if (key == "shoot_dir") valid = ParseShootDir(value, sc.game.shootDir);
+		else if (key == "fire") valid = ParseBool(value, sc.fire);
+		else if (key == "fire_rate") valid = ParseFloat(value, sc.game.fireRateScale) && sc.game.fireRateScale > 0.f;
+		else if (key == "invulnerable") valid = ParseBool(value, sc.game.invulnerable);
+		else if (key == "endless") valid = ParseBool(value, sc.game.endless);
+		else if (key == "broadphase") valid = ParseBroadphase(value.c_str(), sc.broadphase);
+		else {
+			fprintf(stderr, "%s:%d: unknown key '%s'\n", path, lineNo, key.c_str());
+			ok = false;
+			break;
+		}
+		if (!valid) {
+			fprintf(stderr, "%s:%d: invalid value '%s' for '%s'\n", path, lineNo, raw.c_str(), key.c_str());
+			ok = false;
+		}
+	}
+	fclose(f);
+
+	if (ok && sc.game.spawnMin > sc.game.spawnMax) {
+		fprintf(stderr, "%s: spawn_min is greater than spawn_max\n", path);
+		ok = false;
+	}
+	if (ok) out = sc;
+	return ok;
+}
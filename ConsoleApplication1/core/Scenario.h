@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Broadphase.h"
+#include "Game.h"
+#include "Input.h"
+
+// --- SCENARIOS ---
+// Powtarzalny profil obciążenia dla benchmarków headless, np. "PLASMA z 2000 asteroid".
+// Plik tekstowy "klucz = wartość", komentarze od '#':
+//
+//   name         = plasma_spam_2000
+//   seed         = 42
+//   ticks        = 7200          # domyślna długość przebiegu
+//   spawn_min    = 0.002         # przedział odstępu między spawnami, s
+//   spawn_max    = 0.004
+//   spawn_batch  = 4             # asteroid na spawn (najwyżej jeden spawn na tick)
+//   max_ast      = 2000          # nadpisuje Game::MAX_AST
+//   weapon       = plasma        # laser | bullet | rocket | plasma
+//   shoot_dir    = up            # up | right | down | left
+//   fire         = true          # ciągły ogień
+//   fire_rate    = 4             # mnożnik tempa ognia broni
+//   invulnerable = true          # statek nie ginie, więc obciążenie się nie zeruje
+//   endless      = true          # zestrzelenie BigAsteroid nie kończy przebiegu
+//   broadphase   = grid          # grid | sap | tree | brute
+//
+// Pominięte klucze mają wartości zwykłej gry (Game::Config).
+
+struct Scenario {
+	std::string name;
+	uint64_t seed = 1;
+	long long ticks = static_cast<long long>(60 * Game::C_TICK_RATE);
+	bool fire = true;
+	BroadphaseKind broadphase = BroadphaseKind::GRID;
+	Game::Config game;
+};
+
+// Wczytuje scenariusz; przy błędzie wypisuje plik, linię i powód na stderr i zwraca false.
+// Bez klucza name nazwą jest ścieżka pliku.
+bool LoadScenario(const char* path, Scenario& out);
+
+// Wejście jednego ticku: ogień według scenariusza, restart tylko po śmierci (R przy żywym
+// statku odpaliłby pocisk specjalny i zmienił profil obciążenia)
+inline InputState ScenarioInput(const Scenario& sc, const Game& game) {
+	InputState in;
+	in.fire = sc.fire;
+	in.restart = !game.GetPlayer().IsAlive();
+	return in;
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <raylib.h>
+
+#include "Components.h"
+#include "Input.h"
+
+// --- SHIP HIERARCHY ---
+class Ship {
+public:
+	void SetHP(int value) { hp = value; }
+	Ship(int screenW, int screenH) {
+		Respawn(screenW, screenH);
+	}
+
+	// Stan startowy na środku ekranu (konstruktor i restart gry)
+	void Respawn(int screenW, int screenH) {
+		transform = TransformA{};
+		transform.position = {
+												 screenW * 0.5f,
+												 screenH * 0.5f
+		};
+		hp = 100;
+		speed = 250.f;
+		alive = true;
+	}
+	virtual ~Ship() = default;
+	virtual void Update(float dt, const InputState& in) = 0;
+
+	void TakeDamage(int dmg) {
+		if (!alive) return;
+		hp -= dmg;
+		if (hp <= 0) alive = false;
+	}
+
+	bool IsAlive() const {
+		return alive;
+	}
+
+	Vector2 GetPosition() const {
+		return transform.position;
+	}
+
+	virtual float GetRadius() const = 0;
+
+	int GetHP() const {
+		return hp;
+	}
+
+protected:
+	TransformA transform;
+	int        hp;
+	float      speed;
+	bool       alive;
+};
+
+class PlayerShip :public Ship {
+public:
+	// Promień podaje front-end (z tekstury) albo tryb headless (stała z wymiarów sprite'a)
+	PlayerShip(int w, int h, float shipRadius) : Ship(w, h), radius(shipRadius) {}
+
+	void Update(float dt, const InputState& in) override {
+		if (alive) {
+			if (in.moveUp) transform.position.y -= speed * dt;
+			if (in.moveDown) transform.position.y += speed * dt;
+			if (in.moveLeft) transform.position.x -= speed * dt;
+			if (in.moveRight) transform.position.x += speed * dt;
+		}
+		else {
+			transform.position.y += speed * dt;
+		}
+	}
+
+	float GetRadius() const override {
+		return radius;
+	}
+
+private:
+	float radius;
+};
@@ -0,0 +1,217 @@
+﻿#include "SimdKernels.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#define ASTEROIDS_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ASTEROIDS_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+	inline bool OutOfBounds(float x, float y, float m, float w, float h) {
+		return x < -m || x > w + m || y < -m || y > h + m;
+	}
+
+	// Ruch względny: drugi okrąg stoi, pierwszy przesuwa się o d
+	inline float SweptCircleToiOne(float x0, float y0, float dx, float dy, float r,
+		float cx, float cy, float cr, float cvx, float cvy, float dt) {
+		float mx = x0 - cx;
+		float my = y0 - cy;
+		float rdx = dx - cvx * dt;
+		float rdy = dy - cvy * dt;
+		float rs = r + cr;
+
+		float c = mx * mx + my * my - rs * rs;
+		if (c < 0.f) return 0.f;
+		float a = rdx * rdx + rdy * rdy;
+		float b = mx * rdx + my * rdy;
+		float disc = b * b - a * c;
+		// b < 0: okręgi się zbliżają; pierwszy pierwiastek to moment zetknięcia
+		if (a > 0.f && b < 0.f && disc >= 0.f) {
+			float root = (-b - sqrtf(disc)) / a;
+			if (root <= 1.f) return root;
+		}
+		return C_TOI_NONE;
+	}
+}
+
+const char* SimdKernelName() {
+#if defined(ASTEROIDS_SIMD_AVX2)
+	return "avx2";
+#elif defined(ASTEROIDS_SIMD_SSE2)
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
+
+void IntegrateMarkOutOfBounds(float* posX, float* posY, const float* velX, const float* velY,
+	const float* margin, size_t n, float dt, float w, float h, char* outOfBounds) {
+	size_t i = 0;
+#if defined(ASTEROIDS_SIMD_AVX2)
+	const __m256 vdt = _mm256_set1_ps(dt);
+	const __m256 vw = _mm256_set1_ps(w);
+	const __m256 vh = _mm256_set1_ps(h);
+	const __m256 sign = _mm256_set1_ps(-0.f);
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_add_ps(_mm256_loadu_ps(posX + i), _mm256_mul_ps(_mm256_loadu_ps(velX + i), vdt));
+		__m256 y = _mm256_add_ps(_mm256_loadu_ps(posY + i), _mm256_mul_ps(_mm256_loadu_ps(velY + i), vdt));
+		_mm256_storeu_ps(posX + i, x);
+		_mm256_storeu_ps(posY + i, y);
+
+		__m256 m = margin ? _mm256_loadu_ps(margin + i) : _mm256_setzero_ps();
+		__m256 lo = _mm256_xor_ps(m, sign);
+		__m256 out = _mm256_or_ps(
+			_mm256_or_ps(_mm256_cmp_ps(x, lo, _CMP_LT_OQ), _mm256_cmp_ps(x, _mm256_add_ps(vw, m), _CMP_GT_OQ)),
+			_mm256_or_ps(_mm256_cmp_ps(y, lo, _CMP_LT_OQ), _mm256_cmp_ps(y, _mm256_add_ps(vh, m), _CMP_GT_OQ)));
+		int bits = _mm256_movemask_ps(out);
+		if (bits) {
+			for (int k = 0; k < 8; ++k) outOfBounds[i + k] |= static_cast<char>((bits >> k) & 1);
+		}
+	}
+#elif defined(ASTEROIDS_SIMD_SSE2)
+	const __m128 vdt = _mm_set1_ps(dt);
+	const __m128 vw = _mm_set1_ps(w);
+	const __m128 vh = _mm_set1_ps(h);
+	const __m128 sign = _mm_set1_ps(-0.f);
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_add_ps(_mm_loadu_ps(posX + i), _mm_mul_ps(_mm_loadu_ps(velX + i), vdt));
+		__m128 y = _mm_add_ps(_mm_loadu_ps(posY + i), _mm_mul_ps(_mm_loadu_ps(velY + i), vdt));
+		_mm_storeu_ps(posX + i, x);
+		_mm_storeu_ps(posY + i, y);
+
+		__m128 m = margin ? _mm_loadu_ps(margin + i) : _mm_setzero_ps();
+		__m128 lo = _mm_xor_ps(m, sign);
+		__m128 out = _mm_or_ps(
+			_mm_or_ps(_mm_cmplt_ps(x, lo), _mm_cmpgt_ps(x, _mm_add_ps(vw, m))),
+			_mm_or_ps(_mm_cmplt_ps(y, lo), _mm_cmpgt_ps(y, _mm_add_ps(vh, m))));
+		int bits = _mm_movemask_ps(out);
+		if (bits) {
+			for (int k = 0; k < 4; ++k) outOfBounds[i + k] |= static_cast<char>((bits >> k) & 1);
+		}
+	}
+#endif
+	for (; i < n; ++i) {
+		posX[i] += velX[i] * dt;
+		posY[i] += velY[i] * dt;
+		if (OutOfBounds(posX[i], posY[i], margin ? margin[i] : 0.f, w, h)) outOfBounds[i] = 1;
+	}
+}
+
+size_t CircleOverlapMask(float x, float y, float r, const float* cx, const float* cy, const float* cr,
+	size_t n, char* hits) {
+	size_t count = 0;
+	size_t i = 0;
+#if defined(ASTEROIDS_SIMD_AVX2)
+	const __m256 vx = _mm256_set1_ps(x);
+	const __m256 vy = _mm256_set1_ps(y);
+	const __m256 vr = _mm256_set1_ps(r);
+	for (; i + 8 <= n; i += 8) {
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(cx + i), vx);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(cy + i), vy);
+		__m256 rs = _mm256_add_ps(_mm256_loadu_ps(cr + i), vr);
+		__m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		int bits = _mm256_movemask_ps(_mm256_cmp_ps(d2, _mm256_mul_ps(rs, rs), _CMP_LT_OQ));
+		for (int k = 0; k < 8; ++k) {
+			char hit = static_cast<char>((bits >> k) & 1);
+			hits[i + k] = hit;
+			count += static_cast<size_t>(hit);
+		}
+	}
+#elif defined(ASTEROIDS_SIMD_SSE2)
+	const __m128 vx = _mm_set1_ps(x);
+	const __m128 vy = _mm_set1_ps(y);
+	const __m128 vr = _mm_set1_ps(r);
+	for (; i + 4 <= n; i += 4) {
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(cx + i), vx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(cy + i), vy);
+		__m128 rs = _mm_add_ps(_mm_loadu_ps(cr + i), vr);
+		__m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		int bits = _mm_movemask_ps(_mm_cmplt_ps(d2, _mm_mul_ps(rs, rs)));
+		for (int k = 0; k < 4; ++k) {
+			char hit = static_cast<char>((bits >> k) & 1);
+			hits[i + k] = hit;
+			count += static_cast<size_t>(hit);
+		}
+	}
+#endif
+	for (; i < n; ++i) {
+		float dx = cx[i] - x;
+		float dy = cy[i] - y;
+		float rs = cr[i] + r;
+		char hit = static_cast<char>(dx * dx + dy * dy < rs * rs);
+		hits[i] = hit;
+		count += static_cast<size_t>(hit);
+	}
+	return count;
+}
+
+size_t SweptCircleToi(float x0, float y0, float dx, float dy, float r,
+	const float* cx, const float* cy, const float* cr, const float* cvx, const float* cvy, float dt,
+	size_t n, float* toi) {
+	size_t hits = 0;
+	size_t i = 0;
+	// Wersje wektorowe liczą obie gałęzie i wybierają wynik maską; kolejność działań jak w skalarnej
+#if defined(ASTEROIDS_SIMD_AVX2)
+	const __m256 vx0 = _mm256_set1_ps(x0), vy0 = _mm256_set1_ps(y0);
+	const __m256 vdx = _mm256_set1_ps(dx), vdy = _mm256_set1_ps(dy);
+	const __m256 vr = _mm256_set1_ps(r), vdt = _mm256_set1_ps(dt);
+	const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.f), none = _mm256_set1_ps(C_TOI_NONE);
+	const __m256 sign = _mm256_set1_ps(-0.f);
+	for (; i + 8 <= n; i += 8) {
+		__m256 mx = _mm256_sub_ps(vx0, _mm256_loadu_ps(cx + i));
+		__m256 my = _mm256_sub_ps(vy0, _mm256_loadu_ps(cy + i));
+		__m256 rdx = _mm256_sub_ps(vdx, _mm256_mul_ps(_mm256_loadu_ps(cvx + i), vdt));
+		__m256 rdy = _mm256_sub_ps(vdy, _mm256_mul_ps(_mm256_loadu_ps(cvy + i), vdt));
+		__m256 rs = _mm256_add_ps(vr, _mm256_loadu_ps(cr + i));
+
+		__m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(mx, mx), _mm256_mul_ps(my, my)), _mm256_mul_ps(rs, rs));
+		__m256 a = _mm256_add_ps(_mm256_mul_ps(rdx, rdx), _mm256_mul_ps(rdy, rdy));
+		__m256 b = _mm256_add_ps(_mm256_mul_ps(mx, rdx), _mm256_mul_ps(my, rdy));
+		__m256 disc = _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(a, c));
+		__m256 root = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(b, sign), _mm256_sqrt_ps(_mm256_max_ps(disc, zero))), a);
+		__m256 valid = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(a, zero, _CMP_GT_OQ), _mm256_cmp_ps(b, zero, _CMP_LT_OQ)),
+			_mm256_and_ps(_mm256_cmp_ps(disc, zero, _CMP_GE_OQ), _mm256_cmp_ps(root, one, _CMP_LE_OQ)));
+		__m256 t = _mm256_blendv_ps(none, root, valid);
+		t = _mm256_blendv_ps(t, zero, _mm256_cmp_ps(c, zero, _CMP_LT_OQ));
+		_mm256_storeu_ps(toi + i, t);
+		int bits = _mm256_movemask_ps(_mm256_cmp_ps(t, one, _CMP_LE_OQ));
+		for (int k = 0; k < 8; ++k) hits += static_cast<size_t>((bits >> k) & 1);
+	}
+#elif defined(ASTEROIDS_SIMD_SSE2)
+	const __m128 vx0 = _mm_set1_ps(x0), vy0 = _mm_set1_ps(y0);
+	const __m128 vdx = _mm_set1_ps(dx), vdy = _mm_set1_ps(dy);
+	const __m128 vr = _mm_set1_ps(r), vdt = _mm_set1_ps(dt);
+	const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f), none = _mm_set1_ps(C_TOI_NONE);
+	const __m128 sign = _mm_set1_ps(-0.f);
+	for (; i + 4 <= n; i += 4) {
+		__m128 mx = _mm_sub_ps(vx0, _mm_loadu_ps(cx + i));
+		__m128 my = _mm_sub_ps(vy0, _mm_loadu_ps(cy + i));
+		__m128 rdx = _mm_sub_ps(vdx, _mm_mul_ps(_mm_loadu_ps(cvx + i), vdt));
+		__m128 rdy = _mm_sub_ps(vdy, _mm_mul_ps(_mm_loadu_ps(cvy + i), vdt));
+		__m128 rs = _mm_add_ps(vr, _mm_loadu_ps(cr + i));
+
+		__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)), _mm_mul_ps(rs, rs));
+		__m128 a = _mm_add_ps(_mm_mul_ps(rdx, rdx), _mm_mul_ps(rdy, rdy));
+		__m128 b = _mm_add_ps(_mm_mul_ps(mx, rdx), _mm_mul_ps(my, rdy));
+		__m128 disc = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, c));
+		__m128 root = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(b, sign), _mm_sqrt_ps(_mm_max_ps(disc, zero))), a);
+		__m128 valid = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(a, zero), _mm_cmplt_ps(b, zero)),
+			_mm_and_ps(_mm_cmpge_ps(disc, zero), _mm_cmple_ps(root, one)));
+		__m128 t = _mm_or_ps(_mm_and_ps(valid, root), _mm_andnot_ps(valid, none));
+		t = _mm_andnot_ps(_mm_cmplt_ps(c, zero), t); // c < 0: t = 0
+		_mm_storeu_ps(toi + i, t);
+		int bits = _mm_movemask_ps(_mm_cmple_ps(t, one));
+		for (int k = 0; k < 4; ++k) hits += static_cast<size_t>((bits >> k) & 1);
+	}
+#endif
+	for (; i < n; ++i) {
+		float t = SweptCircleToiOne(x0, y0, dx, dy, r, cx[i], cy[i], cr[i], cvx[i], cvy[i], dt);
+		toi[i] = t;
+		hits += t <= 1.f;
+	}
+	return hits;
+}
@@ -0,0 +1,31 @@
+﻿#pragma once
+#include <cstddef>
+
+// --- SIMD KERNELS ---
+// Pętle po tablicach SoA w wersjach AVX2 (z -mavx2 / /arch:AVX2, opcja ASTEROIDS_AVX2),
+// SSE2 (każdy x86-64) i skalarnej. Wybór przy kompilacji. Bez FMA, więc wszystkie wersje
+// liczą bit w bit to samo co kod skalarny i nie psują determinizmu nagrań.
+
+constexpr float C_TOI_NONE = 2.f; // SweptCircleToi: brak zetknięcia w tym ticku
+
+// "avx2", "sse2" albo "scalar"
+const char* SimdKernelName();
+
+// pos += vel * dt dla n elementów; outOfBounds[i] |= 1, jeśli punkt po ruchu wyszedł poza
+// [-m, w + m] x [-m, h + m], gdzie m = margin[i] (margin == nullptr oznacza 0).
+void IntegrateMarkOutOfBounds(float* posX, float* posY, const float* velX, const float* velY,
+	const float* margin, size_t n, float dt, float w, float h, char* outOfBounds);
+
+// hits[i] = 1, jeśli okrąg (x, y, r) nachodzi na okrąg (cx[i], cy[i], cr[i]), inaczej 0.
+// Porównanie kwadratów odległości: dx² + dy² < (r + cr)², bez sqrt. Zwraca liczbę trafień.
+size_t CircleOverlapMask(float x, float y, float r, const float* cx, const float* cy, const float* cr,
+	size_t n, char* hits);
+
+// Zderzenie ciągłe (swept circle): zamiast sprawdzać tylko pozycje końcowe, szukamy najwcześniejszego
+// t w [0, 1], w którym okręgi się stykają, więc szybki pocisk nie przeskoczy małej asteroidy.
+// Okrąg (x0, y0, r) przesuwa się w ticku o (dx, dy); okrąg i startuje z (cx[i], cy[i]) i przesuwa
+// się o (cvx[i], cvy[i]) * dt. toi[i] = najwcześniejsze t zetknięcia (0, jeśli nachodzą od początku)
+// albo C_TOI_NONE. Zwraca liczbę trafień.
+size_t SweptCircleToi(float x0, float y0, float dx, float dy, float r,
+	const float* cx, const float* cy, const float* cr, const float* cvx, const float* cvy, float dt,
+	size_t n, float* toi);
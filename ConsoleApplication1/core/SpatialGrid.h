@@ -0,0 +1,127 @@
+﻿#pragma once
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <raylib.h>
+
+// --- SPATIAL GRID ---
+// Jednorodna siatka nad ekranem (broadphase). Obiekty poza ekranem trafiają do komórek brzegowych,
+// więc każda para nakładających się okręgów ma co najmniej jedną wspólną komórkę.
+// Zawartość komórek leży w jednej tablicy (sortowanie przez zliczanie: cellStart[c]..cellStart[c+1]),
+// więc po Reserve budowa i zapytania nie alokują. Insert po Build trafia na krótką listę dodatkową.
+class SpatialGrid {
+public:
+	void Reset(int worldW, int worldH, float cell) {
+		invCell = 1.f / cell;
+		cols = std::max(1, static_cast<int>(ceilf(worldW * invCell)));
+		rows = std::max(1, static_cast<int>(ceilf(worldH * invCell)));
+		cellStart.assign(static_cast<size_t>(cols) * rows + 1, 0);
+		cellFill.assign(static_cast<size_t>(cols) * rows, 0);
+		Clear();
+	}
+
+	// Miejsce na objects obiektów o promieniu do maxRadius (po Reset). Okrąg zajmuje najwyżej
+	// floor(2r / cell) + 2 komórek w każdej osi.
+	void Reserve(size_t objects, float maxRadius) {
+		const size_t span = static_cast<size_t>(2.f * maxRadius * invCell) + 2;
+		const size_t perObject = std::min(span * span, cellFill.size());
+		entries.reserve(objects * perObject);
+		late.reserve(objects);
+		stamp.reserve(objects);
+	}
+
+	void Clear() {
+		std::fill(cellStart.begin(), cellStart.end(), 0);
+		entries.clear();
+		late.clear();
+	}
+
+	// Cała siatka od zera; id to indeksy 0..n-1, w każdej komórce rosnąco
+	void Build(const float* x, const float* y, const float* r, size_t n) {
+		std::fill(cellStart.begin(), cellStart.end(), 0);
+		late.clear();
+		for (size_t i = 0; i < n; ++i) {
+			const Rect c = Cells(x[i], y[i], r[i]);
+			for (int cy = c.y0; cy <= c.y1; ++cy)
+				for (int cx = c.x0; cx <= c.x1; ++cx)
+					cellStart[static_cast<size_t>(cy) * cols + cx + 1]++;
+		}
+		for (size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+		entries.resize(cellStart.back());
+		std::copy(cellStart.begin(), cellStart.end() - 1, cellFill.begin());
+		for (size_t i = 0; i < n; ++i) {
+			const Rect c = Cells(x[i], y[i], r[i]);
+			for (int cy = c.y0; cy <= c.y1; ++cy)
+				for (int cx = c.x0; cx <= c.x1; ++cx)
+					entries[cellFill[static_cast<size_t>(cy) * cols + cx]++] = static_cast<int>(i);
+		}
+		if (stamp.size() < n) stamp.resize(n, 0);
+	}
+
+	// Pojedynczy obiekt po Build (np. BigAsteroid w trakcie ticku)
+	void Insert(int id, Vector2 pos, float radius) {
+		late.push_back({ id, Cells(pos.x, pos.y, radius) });
+		if (stamp.size() <= static_cast<size_t>(id)) stamp.resize(static_cast<size_t>(id) + 1, 0);
+	}
+
+	// Kandydaci posortowani rosnąco, czyli w tej samej kolejności co pętla brute-force
+	void Query(Vector2 pos, float radius, std::vector<int>& out) const {
+		out.clear();
+		if (++queryStamp == 0) { // przepełnienie licznika - stare znaczniki mogłyby się zgadzać
+			std::fill(stamp.begin(), stamp.end(), 0);
+			queryStamp = 1;
+		}
+		const Rect q = Cells(pos.x, pos.y, radius);
+		for (int cy = q.y0; cy <= q.y1; ++cy)
+			for (int cx = q.x0; cx <= q.x1; ++cx) {
+				const size_t c = static_cast<size_t>(cy) * cols + cx;
+				for (uint32_t e = cellStart[c]; e < cellStart[c + 1]; ++e) {
+					const int id = entries[e];
+					if (stamp[id] == queryStamp) continue;
+					stamp[id] = queryStamp;
+					out.push_back(id);
+				}
+			}
+		for (const LateEntry& l : late) {
+			if (l.cells.x1 < q.x0 || l.cells.x0 > q.x1 || l.cells.y1 < q.y0 || l.cells.y0 > q.y1) continue;
+			if (stamp[l.id] == queryStamp) continue;
+			stamp[l.id] = queryStamp;
+			out.push_back(l.id);
+		}
+		if (out.size() > 1) std::sort(out.begin(), out.end());
+	}
+
+private:
+	struct Rect {
+		int x0, x1, y0, y1;
+	};
+
+	struct LateEntry {
+		int id;
+		Rect cells;
+	};
+
+	Rect Cells(float x, float y, float radius) const {
+		return { CellX(x - radius), CellX(x + radius), CellY(y - radius), CellY(y + radius) };
+	}
+
+	int CellX(float x) const {
+		return std::clamp(static_cast<int>(floorf(x * invCell)), 0, cols - 1);
+	}
+
+	int CellY(float y) const {
+		return std::clamp(static_cast<int>(floorf(y * invCell)), 0, rows - 1);
+	}
+
+	std::vector<uint32_t> cellStart; // cols * rows + 1 przesunięć w entries
+	std::vector<uint32_t> cellFill;  // kursory zapisu przy Build
+	std::vector<int> entries;
+	std::vector<LateEntry> late;
+	mutable std::vector<uint32_t> stamp; // ostatnie zapytanie, które zwróciło dany id (bez duplikatów)
+	mutable uint32_t queryStamp = 0;
+	float invCell = 1.f;
+	int cols = 1;
+	int rows = 1;
+};
@@ -0,0 +1,80 @@
+﻿#include "SweepAndPrune.h"
+
+#include <algorithm>
+
+void SweepAndPrune::Build(const float* x, const float* y, const float* r, size_t n) {
+	// Oś o większej wariancji środków
+	double sx = 0, sy = 0, sxx = 0, syy = 0;
+	for (size_t i = 0; i < n; ++i) {
+		sx += x[i]; sxx += static_cast<double>(x[i]) * x[i];
+		sy += y[i]; syy += static_cast<double>(y[i]) * y[i];
+	}
+	if (n > 0) {
+		double varX = sxx - sx * sx / n;
+		double varY = syy - sy * sy / n;
+		axis = varY > varX ? 1 : 0;
+	}
+	const float* a = axis ? y : x;
+	const float* b = axis ? x : y;
+
+	// Kolejność z poprzedniej klatki bez usuniętych id, nowe id na końcu
+	size_t kept = 0;
+	for (int id : order) {
+		if (static_cast<size_t>(id) < n) order[kept++] = id;
+	}
+	order.resize(kept);
+	for (size_t id = kept; id < n; ++id) order.push_back(static_cast<int>(id));
+
+	minA.resize(n); maxA.resize(n);
+	minB.resize(n); maxB.resize(n);
+	maxRadius = 0.f;
+	for (size_t k = 0; k < n; ++k) {
+		int id = order[k];
+		minA[k] = a[id] - r[id]; maxA[k] = a[id] + r[id];
+		minB[k] = b[id] - r[id]; maxB[k] = b[id] + r[id];
+		maxRadius = std::max(maxRadius, r[id]);
+	}
+
+	swaps = 0;
+	for (size_t k = 1; k < n; ++k) {
+		float key = minA[k];
+		if (minA[k - 1] <= key) continue;
+		int id = order[k];
+		float kmax = maxA[k], kminB = minB[k], kmaxB = maxB[k];
+		size_t j = k;
+		for (; j > 0 && minA[j - 1] > key; --j) {
+			order[j] = order[j - 1];
+			minA[j] = minA[j - 1]; maxA[j] = maxA[j - 1];
+			minB[j] = minB[j - 1]; maxB[j] = maxB[j - 1];
+		}
+		swaps += k - j;
+		order[j] = id;
+		minA[j] = key; maxA[j] = kmax;
+		minB[j] = kminB; maxB[j] = kmaxB;
+	}
+}
+
+void SweepAndPrune::Insert(int id, Vector2 pos, float radius) {
+	float a = axis ? pos.y : pos.x;
+	float b = axis ? pos.x : pos.y;
+	size_t k = static_cast<size_t>(std::upper_bound(minA.begin(), minA.end(), a - radius) - minA.begin());
+	order.insert(order.begin() + k, id);
+	minA.insert(minA.begin() + k, a - radius); maxA.insert(maxA.begin() + k, a + radius);
+	minB.insert(minB.begin() + k, b - radius); maxB.insert(maxB.begin() + k, b + radius);
+	maxRadius = std::max(maxRadius, radius);
+}
+
+void SweepAndPrune::Query(Vector2 pos, float radius, std::vector<int>& out) const {
+	out.clear();
+	float qa = axis ? pos.y : pos.x;
+	float qb = axis ? pos.x : pos.y;
+	float qminA = qa - radius, qmaxA = qa + radius;
+	float qminB = qb - radius, qmaxB = qb + radius;
+
+	// Przedział o środku w zasięgu ma min >= qminA - 2 * maxRadius (+1 px zapasu na zaokrąglenia)
+	size_t k = static_cast<size_t>(std::lower_bound(minA.begin(), minA.end(), qminA - 2.f * maxRadius - 1.f) - minA.begin());
+	for (; k < minA.size() && minA[k] <= qmaxA; ++k) {
+		if (maxA[k] >= qminA && minB[k] <= qmaxB && maxB[k] >= qminB) out.push_back(order[k]);
+	}
+	if (out.size() > 1) std::sort(out.begin(), out.end());
+}
@@ -0,0 +1,45 @@
+﻿#pragma once
+#include <vector>
+#include <cstddef>
+
+#include <raylib.h>
+
+// --- SWEEP AND PRUNE ---
+// Broadphase sortowany po osi o większym rozrzucie środków (asteroidy zbiegają się do środka
+// ekranu, więc przedziały na tej osi mało się nakładają). Kolejność z poprzedniej klatki jest
+// punktem startu sortowania przez wstawianie - przy małym ruchu to prawie O(n).
+// Query zwraca id posortowane rosnąco, czyli tych samych kandydatów w tej samej kolejności
+// co siatka i brute force, tylko z mniejszym nadmiarem.
+class SweepAndPrune {
+public:
+	// Miejsce na n okręgów; Build i Insert do tej liczby nie alokują
+	void Reserve(size_t n) {
+		order.reserve(n);
+		minA.reserve(n); maxA.reserve(n);
+		minB.reserve(n); maxB.reserve(n);
+	}
+
+	// Przelicza przedziały n okręgów (id = indeks) i sortuje je przez wstawianie
+	void Build(const float* x, const float* y, const float* r, size_t n);
+	// Dokłada okrąg między Build (np. BigAsteroid w trakcie przebiegu kolizji)
+	void Insert(int id, Vector2 pos, float radius);
+	void Query(Vector2 pos, float radius, std::vector<int>& out) const;
+
+	int Axis() const {
+		return axis;
+	}
+
+	// Zamiany sortowania w ostatnim Build - miara spójności między klatkami
+	size_t LastSwaps() const {
+		return swaps;
+	}
+
+private:
+	// Wszystkie tablice w kolejności posortowanej po minA
+	std::vector<int> order;
+	std::vector<float> minA, maxA; // przedział na osi sortowania
+	std::vector<float> minB, maxB; // przedział na drugiej osi
+	float maxRadius = 0.f;
+	int axis = 0; // 0 - x, 1 - y
+	size_t swaps = 0;
+};
@@ -0,0 +1,133 @@
+﻿#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS // fopen
+#endif
+#include "TraceRecorder.h"
+
+#include <chrono>
+
+namespace {
+	constexpr auto FLUSH_PERIOD = std::chrono::milliseconds(20);
+}
+
+TraceRecorder::TraceRecorder() {
+	ring.resize(C_RING_EVENTS);
+}
+
+TraceRecorder::~TraceRecorder() {
+	Stop();
+}
+
+int64_t TraceRecorder::NowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool TraceRecorder::Start(const char* path) {
+	Stop();
+	file = fopen(path, "w");
+	if (!file) return false;
+
+	head.store(0);
+	tail.store(0);
+	dropped.store(0);
+	written = 0;
+	originNs = NowNs();
+	stopping.store(false);
+
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+	fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"simulation\"}}", file);
+	flusher = std::thread(&TraceRecorder::FlushLoop, this);
+	return true;
+}
+
+void TraceRecorder::Stop() {
+	if (!file) return;
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		stopping.store(true);
+	}
+	wake.notify_one();
+	flusher.join();
+
+	fputs("\n]}\n", file);
+	fclose(file);
+	file = nullptr;
+}
+
+void TraceRecorder::Push(const Event& e) {
+	uint64_t h = head.load(std::memory_order_relaxed);
+	uint64_t t = tail.load(std::memory_order_acquire);
+	if (h - t >= ring.size()) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	ring[h & (ring.size() - 1)] = e;
+	head.store(h + 1, std::memory_order_release);
+}
+
+void TraceRecorder::Complete(const char* name, int64_t startNs, int64_t durationNs) {
+	if (!file) return;
+	Event e{};
+	e.name = name;
+	e.ts = startNs;
+	e.dur = durationNs;
+	e.phase = 'X';
+	Push(e);
+}
+
+void TraceRecorder::Counter(const char* name, const char* series, double value) {
+	Counter(name, series, value, nullptr, 0.0);
+}
+
+void TraceRecorder::Counter(const char* name, const char* series0, double value0, const char* series1, double value1) {
+	if (!file) return;
+	Event e{};
+	e.name = name;
+	e.series[0] = series0;
+	e.series[1] = series1;
+	e.value[0] = value0;
+	e.value[1] = value1;
+	e.ts = NowNs();
+	e.phase = 'C';
+	Push(e);
+}
+
+void TraceRecorder::WriteEvent(const Event& e) {
+	double tsUs = (e.ts - originNs) * 1e-3;
+	if (e.phase == 'X') {
+		fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+			e.name, tsUs, e.dur * 1e-3);
+	}
+	else {
+		fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"%s\":%g",
+			e.name, tsUs, e.series[0], e.value[0]);
+		if (e.series[1]) fprintf(file, ",\"%s\":%g", e.series[1], e.value[1]);
+		fputs("}}", file);
+	}
+	++written;
+}
+
+size_t TraceRecorder::Drain() {
+	uint64_t t = tail.load(std::memory_order_relaxed);
+	uint64_t h = head.load(std::memory_order_acquire);
+	for (uint64_t i = t; i < h; ++i) {
+		WriteEvent(ring[i & (ring.size() - 1)]);
+	}
+	tail.store(h, std::memory_order_release);
+	return static_cast<size_t>(h - t);
+}
+
+void TraceRecorder::FlushLoop() {
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(wakeMutex);
+			wake.wait_for(lock, FLUSH_PERIOD, [this] { return stopping.load(); });
+		}
+		Drain();
+		if (stopping.load()) {
+			Drain();
+			return;
+		}
+	}
+}
@@ -0,0 +1,77 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// --- TRACE RECORDER ---
+// Zapis zdarzeń w formacie Chrome trace event (JSON; chrome://tracing, ui.perfetto.dev).
+// Wątek gry wkłada zdarzenia do prealokowanego bufora pierścieniowego (jeden producent,
+// jeden konsument, bez blokad i alokacji), a wątek w tle co kilka ms zapisuje je do pliku.
+// Gdy bufor jest pełny, zdarzenie jest odrzucane i liczone - nagrywanie nigdy nie czeka na dysk.
+// Nazwy zdarzeń muszą być stałymi napisami (zapamiętywany jest wskaźnik).
+class TraceRecorder {
+public:
+	static constexpr size_t C_RING_EVENTS = 1 << 16;
+
+	TraceRecorder();
+	~TraceRecorder();
+
+	TraceRecorder(const TraceRecorder&) = delete;
+	TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+	bool Start(const char* path);
+	// Dopisuje resztę bufora i zamyka plik
+	void Stop();
+
+	bool IsRecording() const {
+		return file != nullptr;
+	}
+
+	// Zdarzenie z czasem trwania ("ph":"X"); czasy w ns zegara steady_clock
+	void Complete(const char* name, int64_t startNs, int64_t durationNs);
+	// Ścieżka licznika ("ph":"C") z jedną lub dwiema seriami
+	void Counter(const char* name, const char* series, double value);
+	void Counter(const char* name, const char* series0, double value0, const char* series1, double value1);
+
+	uint64_t Dropped() const {
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+	uint64_t Written() const {
+		return written;
+	}
+
+	static int64_t NowNs();
+
+private:
+	struct Event {
+		const char* name;
+		const char* series[2];
+		double value[2];
+		int64_t ts;
+		int64_t dur;
+		char phase; // 'X' albo 'C'
+	};
+
+	void Push(const Event& e);
+	void FlushLoop();
+	void WriteEvent(const Event& e);
+	size_t Drain();
+
+	std::vector<Event> ring;
+	std::atomic<uint64_t> head{ 0 }; // producent
+	std::atomic<uint64_t> tail{ 0 }; // konsument
+	std::atomic<uint64_t> dropped{ 0 };
+	uint64_t written = 0;
+
+	FILE* file = nullptr;
+	int64_t originNs = 0;
+	std::thread flusher;
+	std::mutex wakeMutex;
+	std::condition_variable wake;
+	std::atomic<bool> stopping{ false };
+};
@@ -0,0 +1,70 @@
+﻿#include "Volley.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	int ClampShots(int n) {
+		return std::clamp(n, 1, VolleyPattern::C_MAX_SHOTS);
+	}
+
+	void Add(VolleyPattern& v, float angle, float speedScale, Vector2 offset) {
+		v.dir[v.count] = { cosf(angle), sinf(angle) };
+		v.speedScale[v.count] = speedScale;
+		v.offset[v.count] = offset;
+		v.count++;
+	}
+}
+
+VolleyPattern VolleyPattern::Single() {
+	VolleyPattern v;
+	Add(v, 0.f, 1.f, {});
+	return v;
+}
+
+VolleyPattern VolleyPattern::Spread(int n, float spreadDeg) {
+	n = ClampShots(n);
+	VolleyPattern v;
+	float step = spreadDeg * DEG2RAD;
+	if (n % 2) {
+		Add(v, 0.f, 1.f, {});
+		for (int k = 1; v.count + 2 <= n; ++k) {
+			Add(v, -step * k, 1.f, {});
+			Add(v, step * k, 1.f, {});
+		}
+		return v;
+	}
+	// Parzyste n: bez środkowego pocisku, pary pod kątem ±(k - 1/2) * spreadDeg
+	for (int k = 1; v.count + 2 <= n; ++k) {
+		Add(v, -step * (k - 0.5f), 1.f, {});
+		Add(v, step * (k - 0.5f), 1.f, {});
+	}
+	return v;
+}
+
+VolleyPattern VolleyPattern::Ring(int n) {
+	n = ClampShots(n);
+	VolleyPattern v;
+	for (int i = 0; i < n; ++i) {
+		Add(v, 2.f * PI * i / n, 1.f, {});
+	}
+	return v;
+}
+
+VolleyPattern VolleyPattern::Burst(int n, float spacing) {
+	n = ClampShots(n);
+	VolleyPattern v;
+	for (int i = 0; i < n; ++i) {
+		Add(v, 0.f, 1.f, { -spacing * i, 0.f });
+	}
+	return v;
+}
+
+VolleyPattern MakeVolley(const WeaponStats& w) {
+	switch (w.volley) {
+	case VolleyKind::RING:  return VolleyPattern::Ring(w.projectiles);
+	case VolleyKind::BURST: return VolleyPattern::Burst(w.projectiles, w.spread);
+	case VolleyKind::SPREAD:
+	default:                return VolleyPattern::Spread(w.projectiles, w.spread);
+	}
+}
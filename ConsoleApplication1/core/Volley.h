@@ -0,0 +1,35 @@
+﻿#pragma once
+#include <raylib.h>
+
+#include "Weapons.h"
+
+// --- VOLLEY ---
+// Wzór salwy liczony raz (trygonometria tylko tutaj). Kierunki i przesunięcia są w układzie
+// strzału: +X to kierunek lufy, +Y jej lewa/prawa strona. Emiter obraca je o kierunek strzału
+// mnożeniem przez wektor jednostkowy, bez atan2f/cosf/sinf na pocisk.
+struct VolleyPattern {
+	static constexpr int C_MAX_SHOTS = 32;
+
+	int count = 0;
+	Vector2 dir[C_MAX_SHOTS] = {};
+	float speedScale[C_MAX_SHOTS] = {};
+	Vector2 offset[C_MAX_SHOTS] = {};
+
+	// Jeden pocisk prosto
+	static VolleyPattern Single();
+	// Środkowy pocisk i pary bocznych pod kątem ±k * spreadDeg (kolejność: środek, -1, +1, -2, +2...).
+	// Dla parzystego n bez środka: pary pod kątem ±(k - 1/2) * spreadDeg, zawsze n pocisków.
+	static VolleyPattern Spread(int n, float spreadDeg);
+	// n pocisków równo dookoła, pierwszy w kierunku strzału
+	static VolleyPattern Ring(int n);
+	// n pocisków jeden za drugim w odstępach spacing px, wszystkie w kierunku strzału
+	static VolleyPattern Burst(int n, float spacing);
+};
+
+// Wzór salwy dla broni z tabeli C_WEAPONS
+VolleyPattern MakeVolley(const WeaponStats& w);
+
+// Obraca wektor z układu strzału o kierunek dir (jednostkowy)
+inline Vector2 RotateToDir(Vector2 v, Vector2 dir) {
+	return { v.x * dir.x - v.y * dir.y, v.x * dir.y + v.y * dir.x };
+}
@@ -0,0 +1,41 @@
+﻿#pragma once
+#include <cstdint>
+
+#include "Components.h"
+
+// --- WEAPONS ---
+enum class WeaponType { LASER, BULLET, ROCKET, PLASMA, SPECIAL, COUNT };
+
+// Układ pocisków w salwie (patrz VolleyPattern)
+enum class VolleyKind : uint8_t { SPREAD, RING, BURST };
+
+// Sposób rysowania pocisku przez front-end
+enum class ProjectileDrawStyle : uint8_t { BEAM, DOT, ROCKET, ORB, NOVA };
+
+// Wszystkie parametry broni w jednym miejscu: strzelanie, kolizje i rysowanie czytają tylko tę tabelę
+struct WeaponStats {
+	const char* name;
+	int damage;
+	float speed;          // px/s
+	float fireRate;       // strzałów/s; 0 - broń nie strzela seriami (SPECIAL odpalany ręcznie)
+	int projectiles;      // pociski w salwie
+	VolleyKind volley;
+	float spread;         // SPREAD: kąt (stopnie) między pociskami, BURST: odstęp (px), RING: nieużywane
+	float radius;         // promień kolizji
+	uint8_t flags;        // EntityFlag
+	ProjectileDrawStyle draw;
+};
+
+// Prędkość serii = odstęp między pociskami (px) * szybkostrzelność, ROCKET/PLASMA z mnożnikiem
+inline constexpr WeaponStats C_WEAPONS[static_cast<int>(WeaponType::COUNT)] = {
+	//  name       dmg  speed               rate   n  volley              spread radius flags          draw
+	{ "LASER",   20, 40.f * 18.f,        18.f, 1, VolleyKind::SPREAD, 0.f,  2.f,  FLAG_NONE,     ProjectileDrawStyle::BEAM },
+	{ "BULLET",  10, 20.f * 22.f,        22.f, 1, VolleyKind::SPREAD, 0.f,  5.f,  FLAG_NONE,     ProjectileDrawStyle::DOT },
+	{ "ROCKET",  40, 20.f * 22.f * 0.6f, 22.f, 1, VolleyKind::SPREAD, 0.f,  2.f,  FLAG_NONE,     ProjectileDrawStyle::ROCKET },
+	{ "PLASMA",  15, 20.f * 22.f * 1.2f, 22.f, 3, VolleyKind::SPREAD, 20.f, 2.f,  FLAG_NONE,     ProjectileDrawStyle::ORB },
+	{ "SPECIAL", 100, 600.f,             0.f,  1, VolleyKind::SPREAD, 0.f,  18.f, FLAG_PIERCING, ProjectileDrawStyle::NOVA },
+};
+
+constexpr const WeaponStats& GetWeaponStats(WeaponType wt) {
+	return C_WEAPONS[static_cast<int>(wt)];
+}
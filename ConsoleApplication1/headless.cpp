@@ -0,0 +1,440 @@
+﻿#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS // fopen
+#endif
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "ProcessMemory.h"
+#include "Game.h"
+#include "InputRecording.h"
+#include "Profiler.h"
+#include "SimdKernels.h"
+#include "TraceRecorder.h"
+
+// Runner bez okna, tekstur i rysowania: ta sama logika gry (core/), stały krok dt,
+// wejście ze skryptu, tyle ticków ile zdąży CPU. Do testów długotrwałych i benchmarków
+// na maszynach bez GPU.
+
+static constexpr float C_HEADLESS_DT = Game::C_TICK_DT;
+static constexpr long long C_HEADLESS_DIR_TICKS = static_cast<long long>(Game::C_TICK_RATE);         // co 1 s
+static constexpr long long C_HEADLESS_WEAPON_TICKS = static_cast<long long>(5 * Game::C_TICK_RATE);  // co 5 s
+static constexpr long long C_SOAK_SHAPE_TICKS = static_cast<long long>(7 * Game::C_TICK_RATE);       // co 7 s
+
+// Skrypt wejścia: ciągły ogień obracany co sekundę, zmiana broni co kilka sekund,
+// apteczka przy niskim HP, pocisk specjalny gdy gotowy, restart po śmierci.
+static InputState HeadlessInput(const Game& game, long long tick) {
+	InputState in;
+	in.fire = true;
+	in.nextShootDir = tick % C_HEADLESS_DIR_TICKS == C_HEADLESS_DIR_TICKS - 1;
+	in.nextWeapon = tick % C_HEADLESS_WEAPON_TICKS == C_HEADLESS_WEAPON_TICKS - 1;
+	in.useHealthpack = game.GetPlayer().GetHP() < 50;
+	in.restart = !game.GetPlayer().IsAlive() || game.IsSpecialReady();
+	return in;
+}
+
+// Soak: ten sam skrypt plus zmiana kształtu asteroid (1-4) co kilka sekund
+static InputState SoakInput(const Game& game, long long tick) {
+	InputState in = HeadlessInput(game, tick);
+	if (tick % C_SOAK_SHAPE_TICKS == C_SOAK_SHAPE_TICKS - 1) {
+		switch ((tick / C_SOAK_SHAPE_TICKS) % 4) {
+		case 0: in.shapeSquare = true; break;
+		case 1: in.shapePentagon = true; break;
+		case 2: in.shapeRandom = true; break;
+		default: in.shapeTriangle = true; break;
+		}
+	}
+	return in;
+}
+
+// Histogram czasu ticku o stałym rozmiarze: 16 przedziałów na oktawę (~6% rozdzielczości).
+// Godziny gry to miliardy ticków, więc pojedynczych czasów nie da się trzymać.
+class TickHistogram {
+public:
+	void Add(int64_t ns) {
+		const uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+		buckets[Bucket(v)]++;
+		count++;
+		maxNs = std::max(maxNs, v);
+	}
+
+	double PercentileMs(double q) const {
+		if (count == 0) return 0.0;
+		const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(count) + 0.5));
+		uint64_t seen = 0;
+		for (int i = 0; i < C_BUCKETS; ++i) {
+			seen += buckets[i];
+			if (seen >= target) {
+				const uint64_t hi = i + 1 < C_BUCKETS ? BucketFloor(i + 1) : maxNs;
+				return 0.5 * static_cast<double>(BucketFloor(i) + hi) * 1e-6;
+			}
+		}
+		return MaxMs();
+	}
+
+	double MaxMs() const {
+		return static_cast<double>(maxNs) * 1e-6;
+	}
+
+	void Reset() {
+		buckets.fill(0);
+		count = 0;
+		maxNs = 0;
+	}
+
+private:
+	static constexpr int C_SUB = 16;
+	static constexpr int C_BUCKETS = 61 * C_SUB; // do 2^64 ns
+
+	// Poniżej 16 ns przedział na każdą ns, wyżej: oktawa (najwyższy bit) i 4 kolejne bity
+	static int Bucket(uint64_t ns) {
+		if (ns < C_SUB) return static_cast<int>(ns);
+		int e = 0;
+		for (uint64_t v = ns; v > 1; v >>= 1) ++e;
+		return (e - 3) * C_SUB + static_cast<int>((ns >> (e - 4)) & (C_SUB - 1));
+	}
+
+	static uint64_t BucketFloor(int i) {
+		if (i < C_SUB) return static_cast<uint64_t>(i);
+		const int e = i / C_SUB + 3;
+		return static_cast<uint64_t>(C_SUB + i % C_SUB) << (e - 4);
+	}
+
+	std::array<uint64_t, C_BUCKETS> buckets{};
+	uint64_t count = 0;
+	uint64_t maxNs = 0;
+};
+
+struct SoakSample {
+	double minutes = 0.0;
+	unsigned long long ticks = 0;    // od startu
+	int sessions = 0;                // nowe gry po końcu (zestrzelony BigAsteroid)
+	int restarts = 0;                // restarty po śmierci (R)
+	double rssMb = 0.0;
+	double liveAllocations = 0.0;    // niezwolnione bloki sterty
+	unsigned long long allocations = 0; // alokacje w tym interwale
+	size_t asteroids = 0;            // szczyt w interwale
+	size_t projectiles = 0;
+	double p50Ms = 0.0, p99Ms = 0.0, maxMs = 0.0;
+};
+
+// Metryka sprawdzana pod kątem dryfu: dopuszczalny wzrost (ułamek) i minimalna zmiana bezwzględna
+// (w jednostkach metryki). Dryf metryki hard kończy soak kodem 1, pozostałe są tylko ostrzeżeniem.
+struct DriftRule {
+	const char* name;
+	double SoakSample::* field;
+	double tolerance;
+	double minDelta;
+	bool hard;
+};
+
+static double Median(std::vector<double> v) {
+	if (v.empty()) return 0.0;
+	std::sort(v.begin(), v.end());
+	size_t h = v.size() / 2;
+	return v.size() % 2 ? v[h] : 0.5 * (v[h - 1] + v[h]);
+}
+
+static double Mad(const std::vector<double>& v, double median) {
+	std::vector<double> dev;
+	dev.reserve(v.size());
+	for (double x : v) dev.push_back(fabs(x - median));
+	return Median(std::move(dev));
+}
+
+// Raport: próbki i dryf. Pierwsza próbka to rozgrzewka (rezerwacje, pierwszy wzrost
+// buforów broadphase), więc porównywana jest mediana pierwszej i ostatniej trzeciej części reszty.
+// Jak w asteroids_bench_compare wzrost liczy się tylko ponad szum (3 odchylenia z MAD obu części),
+// a do tego musi przekroczyć próg względny i bezwzględny - mikrosekundowe ticki skaczą o dziesiątki
+// procent od samego planisty. Zwraca liczbę metryk hard z dryfem (pamięć).
+static int WriteSoakReport(FILE* f, const std::vector<SoakSample>& samples, uint64_t seed, BroadphaseKind broadphase) {
+	fprintf(f, "soak: seed %llu, kernels %s, broadphase %s, %zu samples\n", static_cast<unsigned long long>(seed),
+		SimdKernelName(), BroadphaseName(broadphase), samples.size());
+	fprintf(f, "%8s %12s %8s %8s %9s %12s %10s %9s %9s %9s %9s %9s\n", "minute", "ticks", "sessions", "restarts", "rss MB",
+		"live allocs", "allocs", "asteroids", "proj", "p50 ms", "p99 ms", "max ms");
+	for (const SoakSample& s : samples) {
+		fprintf(f, "%8.1f %12llu %8d %8d %9.2f %12.0f %10llu %9zu %9zu %9.4f %9.4f %9.4f\n", s.minutes, s.ticks, s.sessions,
+			s.restarts, s.rssMb, s.liveAllocations, s.allocations, s.asteroids, s.projectiles, s.p50Ms, s.p99Ms, s.maxMs);
+	}
+
+	constexpr size_t C_MIN_SAMPLES = 4; // rozgrzewka + co najmniej jedna próbka na każdą trzecią część
+	if (samples.size() < C_MIN_SAMPLES) {
+		fprintf(f, "drift: run too short (need at least %zu samples)\n", C_MIN_SAMPLES);
+		return 0;
+	}
+
+	// Wyciek pamięci to błąd; wolniejszy tick na współdzielonej maszynie to tylko sygnał do sprawdzenia
+	constexpr double C_MAD_TO_SIGMA = 1.4826;
+	constexpr double C_NOISE_K = 3.0;
+	const DriftRule rules[] = {
+		{ "rss_mb",           &SoakSample::rssMb,           0.10, 1.0,   true },
+		{ "live_allocations", &SoakSample::liveAllocations, 0.10, 64.0,  true },
+		{ "p50_ms",           &SoakSample::p50Ms,           0.20, 0.005, false },
+		{ "p99_ms",           &SoakSample::p99Ms,           0.25, 0.020, false },
+	};
+	const size_t first = 1, n = samples.size() - first, third = std::max<size_t>(1, n / 3);
+	int drifting = 0, slower = 0;
+	fprintf(f, "%-18s %12s %12s %9s %12s  %s\n", "metric", "early", "late", "change", "noise", "status");
+	for (const DriftRule& rule : rules) {
+		std::vector<double> early, late;
+		for (size_t i = 0; i < third; ++i) {
+			early.push_back(samples[first + i].*rule.field);
+			late.push_back(samples[samples.size() - third + i].*rule.field);
+		}
+		const double e = Median(early), l = Median(late);
+		const double noise = C_MAD_TO_SIGMA * (Mad(early, e) + Mad(late, l));
+		const double change = e > 0.0 ? (l - e) / e : 0.0;
+		const bool grew = change > rule.tolerance && l - e > rule.minDelta && l - e > C_NOISE_K * noise;
+		const char* status = "ok";
+		if (grew && rule.hard) {
+			drifting++;
+			status = "DRIFT";
+		}
+		else if (grew) {
+			slower++;
+			status = "slower (warning)";
+		}
+		fprintf(f, "%-18s %12.4f %12.4f %+8.1f%% %12.4f  %s\n", rule.name, e, l, change * 100.0, noise, status);
+	}
+	fprintf(f, "drift: %d memory metric(s) grew beyond tolerance, %d tick-time warning(s)\n", drifting, slower);
+	return drifting;
+}
+
+// Długi przebieg: gra skryptem przez zadany czas (zegar ścienny), restart po śmierci jak R,
+// nowa sesja po końcu gry. Co interwał próbka RSS, alokacji, encji i percentyli ticku.
+// Kod wyjścia 1, jeśli rośnie pamięć (RSS albo żywe alokacje); wolniejszy tick jest ostrzeżeniem.
+static int RunSoak(uint64_t seed, BroadphaseKind broadphase, double minutes, double intervalSeconds, const char* reportPath) {
+	using Clock = std::chrono::steady_clock;
+	const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(intervalSeconds));
+	const auto duration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(minutes * 60.0));
+
+	std::vector<SoakSample> samples;
+	samples.reserve(static_cast<size_t>(minutes * 60.0 / intervalSeconds) + 2); // bez alokacji w trakcie pomiaru
+	TickHistogram histogram;
+
+	int sessions = 1, restarts = 0;
+	auto game = std::make_unique<Game>(seed);
+	game->SetBroadphase(broadphase);
+	long long sessionTick = 0;
+	unsigned long long ticks = 0;
+	size_t peakAsteroids = 0, peakProjectiles = 0;
+	uint64_t allocationsAtSample = HeapAllocations();
+
+	printf("soak: %.1f min, sample every %.0f s\n", minutes, intervalSeconds);
+	const auto start = Clock::now();
+	auto nextSample = start + interval;
+	for (;;) {
+		if (game->IsEnded()) {
+			game = std::make_unique<Game>(seed + static_cast<uint64_t>(sessions));
+			game->SetBroadphase(broadphase);
+			sessions++;
+			sessionTick = 0;
+		}
+		const InputState in = SoakInput(*game, sessionTick++);
+		if (in.restart && !game->GetPlayer().IsAlive()) restarts++;
+
+		const auto t0 = Clock::now();
+		game->Step(in, C_HEADLESS_DT);
+		const auto t1 = Clock::now();
+		histogram.Add(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+		ticks++;
+		peakAsteroids = std::max(peakAsteroids, game->GetAsteroids().Size());
+		peakProjectiles = std::max(peakProjectiles, game->GetProjectiles().size());
+
+		if (t1 < nextSample) continue;
+		SoakSample s;
+		s.minutes = std::chrono::duration<double>(t1 - start).count() / 60.0;
+		s.ticks = ticks;
+		s.sessions = sessions;
+		s.restarts = restarts;
+		s.rssMb = static_cast<double>(ResidentBytes()) / (1024.0 * 1024.0);
+		s.liveAllocations = static_cast<double>(HeapLiveAllocations());
+		s.allocations = HeapAllocations() - allocationsAtSample;
+		s.asteroids = peakAsteroids;
+		s.projectiles = peakProjectiles;
+		s.p50Ms = histogram.PercentileMs(0.50);
+		s.p99Ms = histogram.PercentileMs(0.99);
+		s.maxMs = histogram.MaxMs();
+		samples.push_back(s);
+		printf("  %6.1f min: %llu ticks, rss %.2f MB, live allocs %.0f, p99 %.4f ms\n", s.minutes, s.ticks, s.rssMb,
+			s.liveAllocations, s.p99Ms);
+		fflush(stdout);
+
+		histogram.Reset();
+		peakAsteroids = peakProjectiles = 0;
+		allocationsAtSample = HeapAllocations();
+		if (t1 - start >= duration) break;
+		nextSample += interval;
+	}
+
+	int drifting = WriteSoakReport(stdout, samples, seed, broadphase);
+	if (reportPath) {
+		FILE* f = fopen(reportPath, "w");
+		if (!f) {
+			fprintf(stderr, "cannot write soak report '%s'\n", reportPath);
+			return 1;
+		}
+		WriteSoakReport(f, samples, seed, broadphase);
+		fclose(f);
+	}
+	return drifting ? 1 : 0;
+}
+
+// Uruchomienie: asteroids_headless [--ticks N] [--seed N] [--record plik | --replay plik]
+//                                  [--profile] [--profile-csv plik] [--trace plik.json] [--check-pools]
+//                                  [--broadphase grid|sap|tree|brute]
+//                                  [--soak MINUTY [--soak-interval SEKUNDY] [--soak-report plik]]
+// Z --replay seed, promień statku i liczba ticków pochodzą z nagrania, a wejście z pliku.
+// --soak gra przez zadany czas zamiast liczby ticków i kończy się raportem dryfu (kod 1 przy wzroście pamięci).
+int main(int argc, char** argv) {
+	long long ticks = static_cast<long long>(600 * Game::C_TICK_RATE); // 10 minut gry
+	uint64_t seed = static_cast<uint64_t>(time(nullptr));
+	const char* recordPath = nullptr;
+	const char* replayPath = nullptr;
+	const char* profileCsvPath = nullptr;
+	const char* tracePath = nullptr;
+	BroadphaseKind broadphase = BroadphaseKind::GRID;
+	bool profile = false;
+	bool checkPools = false; // kod wyjścia 1 przy alokacji sterty po rozgrzewce, przepełnieniu puli albo limicie trafień
+	double soakMinutes = 0.0;
+	double soakInterval = 60.0;
+	const char* soakReportPath = nullptr;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (strcmp(argv[i], "--ticks") == 0) ticks = atoll(argv[++i]);
+		else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+		else if (strcmp(argv[i], "--replay") == 0) replayPath = argv[++i];
+		else if (strcmp(argv[i], "--profile-csv") == 0) profileCsvPath = argv[++i];
+		else if (strcmp(argv[i], "--trace") == 0) tracePath = argv[++i];
+		else if (strcmp(argv[i], "--soak") == 0) soakMinutes = atof(argv[++i]);
+		else if (strcmp(argv[i], "--soak-interval") == 0) soakInterval = atof(argv[++i]);
+		else if (strcmp(argv[i], "--soak-report") == 0) soakReportPath = argv[++i];
+		else if (strcmp(argv[i], "--broadphase") == 0 && !ParseBroadphase(argv[++i], broadphase)) {
+			fprintf(stderr, "unknown broadphase '%s'\n", argv[i]);
+			return 1;
+		}
+	}
+	// Flagi bez wartości mogą też być ostatnim argumentem
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--profile") == 0) profile = true;
+		else if (strcmp(argv[i], "--check-pools") == 0) checkPools = true;
+	}
+	if (soakMinutes > 0.0) {
+		if (soakInterval <= 0.0) {
+			fprintf(stderr, "invalid soak interval\n");
+			return 1;
+		}
+		return RunSoak(seed, broadphase, soakMinutes, soakInterval, soakReportPath);
+	}
+	Profiler::Instance().SetEnabled(profile);
+	if (profileCsvPath && !Profiler::Instance().OpenCsv(profileCsvPath)) {
+		fprintf(stderr, "cannot write profile '%s'\n", profileCsvPath);
+		return 1;
+	}
+	TraceRecorder trace;
+	if (tracePath) {
+		if (!trace.Start(tracePath)) {
+			fprintf(stderr, "cannot write trace '%s'\n", tracePath);
+			return 1;
+		}
+		Profiler::Instance().SetTrace(&trace);
+	}
+
+	InputReplay replay;
+	float shipRadius = Game::C_SHIP_RADIUS;
+	float dt = C_HEADLESS_DT;
+	if (replayPath) {
+		if (!replay.Load(replayPath)) {
+			fprintf(stderr, "cannot load replay '%s'\n", replayPath);
+			return 1;
+		}
+		seed = replay.Header().seed;
+		shipRadius = replay.Header().shipRadius;
+		dt = 1.f / replay.Header().tickRate;
+		ticks = static_cast<long long>(replay.Header().ticks);
+	}
+	InputRecorder recorder(seed, 1.f / dt, shipRadius);
+	if (recordPath) recorder.Reserve(static_cast<size_t>(ticks));
+
+	Game game(seed, shipRadius);
+	game.SetBroadphase(broadphase);
+
+	const long long warmupTicks = static_cast<long long>(1.f / dt); // 1 s gry
+	uint64_t allocationsAfterWarmup = HeapAllocations();
+	auto start = std::chrono::steady_clock::now();
+	long long tick = 0;
+	for (; tick < ticks && !game.IsEnded(); ++tick) {
+		if (tick == warmupTicks) allocationsAfterWarmup = HeapAllocations();
+		InputState in;
+		if (replayPath) {
+			if (!replay.Next(in)) break;
+		}
+		else {
+			in = HeadlessInput(game, tick);
+		}
+		if (recordPath) recorder.Record(in);
+		game.Step(in, dt);
+		Profiler::Instance().EndFrame(); // w headless klatka = tick
+		if (tracePath) {
+			trace.Counter("entities", "asteroids", static_cast<double>(game.GetAsteroids().Size()),
+				"projectiles", static_cast<double>(game.GetProjectiles().size()));
+			trace.Counter("kills", "destroyed", game.GetDestroyedAsteroids());
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const uint64_t steadyAllocations = HeapAllocations() - allocationsAfterWarmup;
+
+	printf("headless: %lld ticks in %.3f s (%.0f ticks/s), seed %llu, kernels %s, broadphase %s\n", tick, seconds,
+		seconds > 0.0 ? tick / seconds : 0.0, static_cast<unsigned long long>(seed), SimdKernelName(), BroadphaseName(broadphase));
+	printf("destroyed asteroids: %d, asteroids: %zu, projectiles: %zu, big asteroid: %s, ended: %s\n",
+		game.GetDestroyedAsteroids(), game.GetAsteroids().Size(), game.GetProjectiles().size(),
+		game.IsBigAsteroidSpawned() ? "YES" : "NO", game.IsEnded() ? "YES" : "NO");
+	printf("state hash: %016llx\n", static_cast<unsigned long long>(game.StateHash()));
+	ProjectilePool::Stats ps = game.GetProjectiles().GetStats();
+	printf("projectile pool: capacity %zu, high-water %zu, acquired %llu, overflow %llu\n",
+		ps.capacity, ps.highWater, static_cast<unsigned long long>(ps.acquired), static_cast<unsigned long long>(ps.overflow));
+	AsteroidStore::Stats as = game.GetAsteroids().GetStats();
+	printf("asteroid store: capacity %zu, high-water %zu, spawned %llu, overflow %llu, allocations %llu\n",
+		as.capacity, as.highWater, static_cast<unsigned long long>(as.spawned), static_cast<unsigned long long>(as.overflow),
+		static_cast<unsigned long long>(as.allocations));
+	printf("heap allocations after warm-up: %llu\n", static_cast<unsigned long long>(steadyAllocations));
+	const uint64_t droppedHits = game.GetDroppedHits();
+	printf("hits over per-projectile cap (%zu): %llu\n", CollisionQuery::C_MAX_HITS_PER_PROJECTILE,
+		static_cast<unsigned long long>(droppedHits));
+
+	if (Profiler::Instance().IsEnabled()) {
+		printf("%-20s %8s %8s  (last %d ticks)\n", "phase", "avg ms", "p99 ms", Profiler::C_HISTORY);
+		for (int p = 0; p < Profiler::C_PHASES; ++p) {
+			ProfilePhase ph = static_cast<ProfilePhase>(p);
+			printf("%-20s %8.4f %8.4f\n", ProfilePhaseName(ph), Profiler::Instance().AverageMs(ph), Profiler::Instance().P99Ms(ph));
+		}
+	}
+	Profiler::Instance().CloseCsv();
+	if (tracePath) {
+		Profiler::Instance().SetTrace(nullptr);
+		trace.Stop();
+		printf("trace: %llu events written, %llu dropped (ring full)\n",
+			static_cast<unsigned long long>(trace.Written()), static_cast<unsigned long long>(trace.Dropped()));
+	}
+
+	if (recordPath && !recorder.Save(recordPath)) {
+		fprintf(stderr, "cannot write recording '%s'\n", recordPath);
+		return 1;
+	}
+	// Game::Game rezerwuje wszystko raz; każda alokacja po rozgrzewce to regresja. Przycięte trafienia
+	// też: bufor zdarzeń o stałym rozmiarze zmienił przebieg gry.
+	if (checkPools && (steadyAllocations > 0 || as.allocations > 1 || as.overflow > 0 || ps.overflow > 0 || droppedHits > 0)) {
+		fprintf(stderr, "pool check failed\n");
+		return 1;
+	}
+	return 0;
+}